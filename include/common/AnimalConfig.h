@@ -12,6 +12,11 @@ const float HERBIVORE_REPRODUCE_ENERGY_COST = 15.0f;
 const float HERBIVORE_REPRODUCE_ENERGY_PERCENTAGE = 0.75f;
 const int HERBIVORE_MIN_REPRODUCE_AGE = 3;
 const int HERD_DETECTION_RADIUS = 10;
+// Lone herbivores with no herd within HERD_DETECTION_RADIUS travel up to HERD_JOIN_RADIUS to join
+// one (a long goal routed through the cluster graph). Off by default: it changes herd behaviour
+// and keeps lone herbivores out of the stable-wander level of detail.
+const bool HERD_JOIN_ENABLED = false;
+const int HERD_JOIN_RADIUS = 48;
 const int HERD_BONUS_RADIUS = 3;
 const float HERD_AGING_REDUCTION_PER_MEMBER = 0.08f; // 8% aging reduction per herd member
 const float MAX_HERD_AGING_REDUCTION = 0.5f;         // Maximum 50% aging reduction
@@ -66,4 +71,31 @@ const float OMNIVORE_MINIMUM_VALUE = 10.0f;
 // --- CARNIVORE FAMILY PROTECTION ---
 const int CARNIVORE_INDEPENDENCE_AGE = 8;  // Young carnivores are protected from parents for 8 turns
 
+// --- TERRAIN EFFECTS ---
+const float FOREST_SIGHT_MODIFIER = 0.5f; // Herbivores and omnivores see half as far inside forests
+
+// --- SCENT TRACKING ---
+// Prey species leave scent on their tile every turn; it spreads to the 4 neighboring tiles and
+// fades, so predators can follow the gradient from beyond their sight radius.
+const float SCENT_DEPOSIT = 1.0f;              // Scent left per animal per turn
+const float SCENT_DIFFUSION = 0.8f;            // Share of a tile's scent spread to its neighbors each turn
+const float SCENT_DECAY = 0.98f;               // Share of scent kept each turn
+const float SCENT_TRACKING_THRESHOLD = 0.02f;  // Weakest scent a predator can pick up
+const int SCENT_TRACKING_STRIDE = 4;           // Tiles ahead along the gradient used as the tracking target
+
+// --- AI LEVEL OF DETAIL ---
+// Animals keep their decision while it is still valid (wanderers: none of the animals they react
+// to in range; others: target still there and no change in the spatial cells they sense) and
+// are re-evaluated every AI_STABLE_DECISION_INTERVAL turns; everyone else decides every turn.
+const int AI_STABLE_DECISION_INTERVAL = 4;
+
+// --- MOVEMENT LIMITS ---
+// Upper bound on tiles an entity can travel in one turn: carnivore base speed (2) + starvation boost (2).
+// Used to pad spatial queries that must also find entities by their previous (interpolated) position.
+const int MAX_MOVE_STEPS_PER_TURN = 4;
+
+// Fleeing animals whose steps away from the threat run into impassable terrain head for a tile
+// this far away in the flee direction instead, routed around the obstacle like any distant goal.
+const int FLEE_GOAL_DISTANCE = 32;
+
 #endif // ANIMAL_CONFIG_H
@@ -7,6 +7,9 @@ enum class AnimalType {
     OMNIVORE,
 };
 
+// Number of AnimalType values, for sizing per-species arrays indexed by static_cast<int>(type)
+const int ANIMAL_TYPE_COUNT = 3;
+
 enum class AIState {
     WANDERING,
     FLEEING,
@@ -14,6 +17,7 @@ enum class AIState {
     PACK_HUNTING,
     HERDING,
     SEEKING_FOOD,
+    TRACKING, // Following a prey scent gradient toward target_x/target_y
 };
 
 #endif // ANIMAL_TYPES_H
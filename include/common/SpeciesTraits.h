@@ -0,0 +1,48 @@
+#ifndef SPECIES_TRAITS_H
+#define SPECIES_TRAITS_H
+
+#include "common/AnimalConfig.h"
+#include "common/AnimalTypes.h"
+
+// Compile-time view of the per-species constants, for system loops instantiated once per
+// species over the EntityManager species ranges (no per-entity switch on the type).
+template <AnimalType Type>
+struct SpeciesTraits;
+
+template <>
+struct SpeciesTraits<AnimalType::HERBIVORE> {
+    static constexpr bool EATS_PLANTS = true;
+    static constexpr bool HAS_HERD_AGING_BONUS = true;
+    static constexpr bool TRACKS_PARENT = false;
+    static constexpr int MIN_SENSING_RADIUS = HERD_DETECTION_RADIUS; // Herd search
+    static constexpr int MIN_REPRODUCE_AGE = HERBIVORE_MIN_REPRODUCE_AGE;
+    static inline const float FOOD_SEEK_THRESHOLD = HERBIVORE_FOOD_SEEK_THRESHOLD_PERCENTAGE;
+    static inline const float REPRODUCE_ENERGY_PERCENTAGE = HERBIVORE_REPRODUCE_ENERGY_PERCENTAGE;
+    static inline const float REPRODUCE_ENERGY_COST = HERBIVORE_REPRODUCE_ENERGY_COST;
+};
+
+template <>
+struct SpeciesTraits<AnimalType::CARNIVORE> {
+    static constexpr bool EATS_PLANTS = false;
+    static constexpr bool HAS_HERD_AGING_BONUS = false;
+    static constexpr bool TRACKS_PARENT = true; // Offspring remember their parent (family protection)
+    static constexpr int MIN_SENSING_RADIUS = CARNIVORE_TERRITORIAL_RADIUS; // Rival check
+    static constexpr int MIN_REPRODUCE_AGE = CARNIVORE_MIN_REPRODUCE_AGE;
+    static inline const float FOOD_SEEK_THRESHOLD = 0.0f; // Never seeks plants
+    static inline const float REPRODUCE_ENERGY_PERCENTAGE = CARNIVORE_REPRODUCE_ENERGY_PERCENTAGE;
+    static inline const float REPRODUCE_ENERGY_COST = CARNIVORE_REPRODUCE_ENERGY_COST;
+};
+
+template <>
+struct SpeciesTraits<AnimalType::OMNIVORE> {
+    static constexpr bool EATS_PLANTS = true;
+    static constexpr bool HAS_HERD_AGING_BONUS = false;
+    static constexpr bool TRACKS_PARENT = false;
+    static constexpr int MIN_SENSING_RADIUS = 0;
+    static constexpr int MIN_REPRODUCE_AGE = OMNIVORE_MIN_REPRODUCE_AGE;
+    static inline const float FOOD_SEEK_THRESHOLD = OMNIVORE_FOOD_SEEK_THRESHOLD_PERCENTAGE;
+    static inline const float REPRODUCE_ENERGY_PERCENTAGE = OMNIVORE_REPRODUCE_ENERGY_PERCENTAGE;
+    static inline const float REPRODUCE_ENERGY_COST = OMNIVORE_REPRODUCE_ENERGY_COST;
+};
+
+#endif // SPECIES_TRAITS_H
@@ -0,0 +1,74 @@
+#ifndef COST_SCHEDULER_H
+#define COST_SCHEDULER_H
+
+#include "core/WorkerPool.h"
+#include <omp.h>
+#include <cstddef>
+#include <vector>
+
+// Busy and idle time of each worker thread in the loops run through CostScheduler,
+// accumulated until reset. Idle time is time spent waiting for the other threads to finish.
+struct LoopThreadStats {
+    std::vector<double> busy_ms;
+    std::vector<double> idle_ms;
+
+    void reset();
+    double getTotalBusyMs() const;
+    double getTotalIdleMs() const;
+    double getIdleFraction() const; // Idle share of all thread time, 0 if nothing ran
+};
+
+// Cost-balanced parallel loops for systems whose per-entity cost varies widely (AI, Metabolism).
+// Items are split into contiguous chunks of about equal estimated cost, several per thread, and
+// threads take chunks from a shared queue as they finish (schedule(dynamic)), so expensive
+// entities spread over all threads instead of piling up in one static block.
+namespace CostScheduler {
+    const int CHUNKS_PER_THREAD = 8;
+
+    // Writes the boundaries of up to chunk_count contiguous chunks over the items to out_bounds
+    // (chunk c is [out_bounds[c], out_bounds[c + 1]); room for chunk_count + 1 values), each
+    // holding about the same total cost. Returns the number of chunks.
+    int buildChunks(const float* costs, size_t item_count, int chunk_count, size_t* out_bounds);
+
+    // Calls body(k) for every k in [0, count), spread over the team in cost-balanced chunks.
+    // Must be reached by every thread of the parallel region (see WorkerPool), with costs
+    // complete; returns after a barrier. Per-thread busy/idle times are added to stats when given.
+    template <typename Body>
+    void parallelFor(const float* costs, size_t count, WorkerPool& pool, LoopThreadStats* stats, const Body& body) {
+        if (count == 0) return;
+
+        int thread_count = omp_get_num_threads();
+        size_t* bounds = nullptr;
+        int chunk_count = 0;
+        #pragma omp single copyprivate(bounds, chunk_count)
+        {
+            bounds = pool.getSharedArena().allocate<size_t>(thread_count * CHUNKS_PER_THREAD + 1);
+            chunk_count = buildChunks(costs, count, thread_count * CHUNKS_PER_THREAD, bounds);
+            if (stats && static_cast<int>(stats->busy_ms.size()) < thread_count) {
+                stats->busy_ms.resize(thread_count, 0.0);
+                stats->idle_ms.resize(thread_count, 0.0);
+            }
+        }
+
+        double start = omp_get_wtime();
+
+        #pragma omp for schedule(dynamic, 1) nowait
+        for (int chunk = 0; chunk < chunk_count; ++chunk) {
+            for (size_t k = bounds[chunk]; k < bounds[chunk + 1]; ++k) {
+                body(k);
+            }
+        }
+
+        double work_end = omp_get_wtime();
+        #pragma omp barrier
+        double end = omp_get_wtime();
+
+        if (stats) {
+            int thread = omp_get_thread_num();
+            stats->busy_ms[thread] += (work_end - start) * 1000.0;
+            stats->idle_ms[thread] += (end - work_end) * 1000.0;
+        }
+    }
+}
+
+#endif // COST_SCHEDULER_H
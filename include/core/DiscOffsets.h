@@ -0,0 +1,32 @@
+#ifndef DISC_OFFSETS_H
+#define DISC_OFFSETS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A tile offset from the center of a disc, with its distance precomputed
+struct DiscOffset {
+    int16_t dx, dy;
+    int distance_sq;
+    float distance; // std::sqrt(float(distance_sq))
+};
+
+// Shared lookup table for radius-limited tile queries.
+//
+// A single table holds every offset within MAX_RADIUS, sorted by distance (ties in row-major
+// order), so the disc of any radius r is the prefix of getCount(r) entries. Walking the prefix
+// visits tiles outward from the center without square-to-circle rejection or a sqrt per tile,
+// and lets a scan stop as soon as distance alone rules out every remaining tile.
+namespace DiscOffsets {
+    const int MAX_RADIUS = 32;
+
+    // Built on first use; thread-safe
+    const std::vector<DiscOffset>& getOffsets();
+
+    // Number of leading offsets with dx² + dy² <= radius² (0 for negative radii).
+    // Radii above MAX_RADIUS are clamped, so callers must handle those separately.
+    size_t getCount(int radius);
+}
+
+#endif // DISC_OFFSETS_H
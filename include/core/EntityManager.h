@@ -4,18 +4,29 @@
 #include "common/AnimalTypes.h"
 #include <vector>
 #include <cstddef> // For size_t
+#include <cstdint>
 
 // Family relationship constants
 const size_t INVALID_PARENT = static_cast<size_t>(-1);
 
+// Index returned by lookups that find no entity
+const size_t INVALID_ENTITY_ID = static_cast<size_t>(-1);
+
+// last_decision_turn of an entity the AI has to decide for on its next run
+const int NO_DECISION_TURN = -1;
+
 class EntityManager {
 public:
     EntityManager();
 
-    // ... (createEntity, destroyEntity, createHerbivore, etc. are the same) ...
+    // ... (createEntity, createHerbivore, etc. are the same) ...
 
     size_t createEntity();
-    void destroyEntity(size_t index);
+    // Drops dead entities and groups the survivors by species (stable, so relative order is
+    // kept). Entity indices change: target_id and parent_id are remapped, and code holding an
+    // index across turns should hold the entity's uid instead (see findEntity).
+    // Called by one thread; inside a parallel region the copying is shared with the rest of the
+    // team through tasks (e.g. while it waits at the end of an "omp single").
     void destroyDeadEntities();
     size_t createHerbivore(int start_x, int start_y);
     size_t createCarnivore(int start_x, int start_y);
@@ -23,9 +34,33 @@ public:
     size_t getEntityCount() const;
     void clear();
 
+    // Current index of the entity with the given uid, or INVALID_ENTITY_ID if it was destroyed
+    size_t findEntity(uint64_t entity_uid) const;
+
+    // --- Species Ranges ---
+    // Since the last destroyDeadEntities, each species occupies the index range [begin, end), in
+    // AnimalType order; entities spawned since then follow the last range.
+    size_t getSpeciesBegin(AnimalType type) const { return m_species_begin[static_cast<int>(type)]; }
+    size_t getSpeciesEnd(AnimalType type) const { return m_species_begin[static_cast<int>(type) + 1]; }
+
+    // Marks an entity dead and updates the population census.
+    // Safe to call from parallel loops as long as each thread only marks its own entity.
+    void markDead(size_t index);
+
+    // --- Population Census ---
+    // Maintained incrementally at spawn, death mark and compaction, so reads are O(1).
+    int getAliveCount(AnimalType type) const { return m_alive_count[static_cast<int>(type)]; }
+    int getTotalAliveCount() const;
+    int getBirthsThisTurn(AnimalType type) const { return m_births_this_turn[static_cast<int>(type)]; }
+    int getDeathsThisTurn(AnimalType type) const { return m_deaths_this_turn[static_cast<int>(type)]; }
+    void beginTurn(); // Resets the per-turn birth/death tallies
+
 public:
     // --- Attribute Arrays (The SoA) ---
-    std::vector<bool>           is_alive;
+    // Byte flags rather than std::vector<bool>: bit-packed flags are not safe to write
+    // from parallel loops even when each thread touches a different entity.
+    std::vector<unsigned char>  is_alive;
+    std::vector<uint64_t>       uid; // Never reused, unlike indices
 
     // Position & State
     std::vector<int>            x;
@@ -37,6 +72,7 @@ public:
     std::vector<size_t>         target_id;
     std::vector<AnimalType>     type;
     std::vector<AIState>        state;
+    std::vector<int>            last_decision_turn; // Turn of the last AI decision (see AISystem LOD)
 
     // Health & Energy
     std::vector<float>          health;
@@ -70,6 +106,17 @@ public:
 
 private:
     size_t num_entities;
+    uint64_t m_next_uid;
+    size_t m_species_begin[ANIMAL_TYPE_COUNT + 1];
+
+    void recordBirth(AnimalType type);
+    void reorder(const std::vector<size_t>& order); // Entity i becomes the entity at order[i]
+    template <typename T>
+    static void gather(std::vector<T>& values, const std::vector<size_t>& order);
+
+    int m_alive_count[ANIMAL_TYPE_COUNT];
+    int m_births_this_turn[ANIMAL_TYPE_COUNT];
+    int m_deaths_this_turn[ANIMAL_TYPE_COUNT];
 };
 
 #endif // ENTITY_MANAGER_H
@@ -0,0 +1,71 @@
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include "common/AnimalTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class World; // Forward declaration to avoid include loop with World.h
+
+// Goals are grouped into FLOW_REGION_SIZE x FLOW_REGION_SIZE tile regions; all entities of a
+// species heading into the same region share one field. Each field covers its region plus
+// FLOW_FIELD_MARGIN tiles on every side (enough for any sight-limited target and a detour).
+const int FLOW_REGION_SIZE = 8;
+const int FLOW_FIELD_MARGIN = 24;
+const int FLOW_FIELD_MAX_IDLE_TURNS = 32; // Fields unused for longer are evicted
+const uint16_t FLOW_FIELD_UNREACHABLE = 0xFFFF;
+
+// Integration field: steps (8-connected, over the species' passable tiles) from each tile of
+// the window to the nearest passable tile of the goal region
+struct FlowField {
+    int origin_x, origin_y; // Window top-left tile
+    int width, height;      // Window size in tiles
+    int region_x, region_y; // Goal region
+    std::vector<uint16_t> distances;
+    int last_used_turn;
+
+    uint16_t getDistance(int x, int y) const {
+        int local_x = x - origin_x;
+        int local_y = y - origin_y;
+        if (local_x < 0 || local_x >= width || local_y < 0 || local_y >= height) return FLOW_FIELD_UNREACHABLE;
+        return distances[static_cast<size_t>(local_y) * width + local_x];
+    }
+
+    bool isInGoalRegion(int x, int y) const {
+        return x / FLOW_REGION_SIZE == region_x && y / FLOW_REGION_SIZE == region_y;
+    }
+};
+
+// Flow fields keyed by (species, goal region). Fields only depend on terrain, so they persist
+// across turns until evicted or until terrain changes (clear).
+class FlowFieldCache {
+public:
+    static uint64_t getKey(AnimalType type, int goal_x, int goal_y);
+
+    // Whether (x, y) lies in the window of the field for the goal's region (its region plus
+    // FLOW_FIELD_MARGIN); outside it the field has no distances for the tile
+    static bool isInWindow(int goal_x, int goal_y, int x, int y);
+
+    // Field for the goal's region, or nullptr if none was prepared. Safe to call concurrently
+    // as long as prepare/clear are not running.
+    const FlowField* find(AnimalType type, int goal_x, int goal_y) const;
+
+    // Ensures a field exists for every key (building missing ones in parallel), marks them used
+    // on this turn and evicts fields idle for more than FLOW_FIELD_MAX_IDLE_TURNS. Reached by
+    // every thread of the turn's parallel region (see WorkerPool), with the same shared keys.
+    void prepare(const uint64_t* keys, size_t key_count, const World& world, int turn);
+
+    void clear() { m_fields.clear(); }
+    size_t size() const { return m_fields.size(); }
+
+private:
+    std::unordered_map<uint64_t, FlowField> m_fields;
+    std::vector<uint64_t> m_missing; // Keys prepare is building, and their fields
+    std::vector<FlowField> m_built;
+
+    static void build(uint64_t key, const World& world, FlowField& out_field);
+};
+
+#endif // FLOW_FIELD_H
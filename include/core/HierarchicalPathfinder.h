@@ -0,0 +1,95 @@
+#ifndef HIERARCHICAL_PATHFINDER_H
+#define HIERARCHICAL_PATHFINDER_H
+
+#include "common/AnimalTypes.h"
+#include "core/FlowField.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class World; // Forward declaration to avoid include loop with World.h
+
+// HPA*: the map is split into PATH_CLUSTER_SIZE x PATH_CLUSTER_SIZE clusters. Every maximal run of
+// passable tile pairs across a cluster border becomes one entrance (a node on each side, joined by
+// a 1-step edge), as does every diagonal pair joining regions no straight run joins, and entrances
+// of the same cluster are joined by their BFS distance inside it.
+// The passable tiles of a cluster fall into regions (8-connected components, like movement);
+// routes run between regions, so they only start from entrances the entity can reach.
+const int PATH_CLUSTER_SIZE = 16;
+
+// Targets farther than this (Chebyshev distance) are routed through the cluster graph; closer ones
+// are inside the goal's flow field window and handled there
+const int HPA_MIN_TARGET_DISTANCE = FLOW_FIELD_MARGIN;
+
+class HierarchicalPathfinder {
+public:
+    static const uint64_t INVALID_ROUTE_KEY = ~static_cast<uint64_t>(0);
+
+    // Builds the abstract graph of the species on first use. Reached by every thread of the
+    // turn's parallel region (see WorkerPool), which share the build.
+    void prepareGraph(AnimalType type, const World& world);
+
+    // Key of the cached route from the region of (from_x, from_y) to the region of (to_x, to_y);
+    // INVALID_ROUTE_KEY if the species' graph is not built or either tile is impassable
+    uint64_t getRouteKey(const World& world, AnimalType type, int from_x, int from_y, int to_x, int to_y) const;
+
+    // Finds the missing routes across the team; their graphs must be prepared. Reached by every
+    // thread of the turn's parallel region, with the same shared keys.
+    void prepareRoutes(const uint64_t* keys, size_t key_count);
+
+    // Next waypoint for an entity at (x, y) heading to (goal_x, goal_y): a tile just inside the
+    // next region of the cached route. False if no route was prepared or the goal's region is
+    // unreachable. Read-only, safe inside the parallel movement loop.
+    bool getWaypoint(const World& world, AnimalType type, int x, int y, int goal_x, int goal_y, int& out_x, int& out_y) const;
+
+    // Drops the graphs and all cached routes; called when terrain changes
+    void clear();
+
+private:
+    struct AbstractEdge {
+        int to;
+        int cost;
+    };
+
+    struct AbstractNode {
+        int x, y;
+        int cluster;
+        int region;
+        std::vector<AbstractEdge> edges;
+    };
+
+    struct AbstractGraph {
+        bool built = false;
+        std::vector<AbstractNode> nodes;
+        std::vector<std::vector<int>> cluster_nodes; // Node IDs per cluster
+        std::vector<std::vector<int>> region_nodes;  // Node IDs per region
+        std::vector<int> cluster_first_region;       // Region count per cluster while labelling, then the first region ID
+        std::vector<int> tile_regions;               // Region of each tile (tile index order), -1 if impassable
+    };
+
+    // Waypoints along a region route: waypoint i is where to head while in regions[i]
+    struct ClusterRoute {
+        bool reachable = false;
+        std::vector<int> regions;
+        std::vector<int> waypoint_x, waypoint_y;
+    };
+
+    // Per-thread Dijkstra state, reset through the touched list instead of a full clear
+    struct RouteSearch {
+        std::vector<int> distances;
+        std::vector<int> previous;
+        std::vector<int> touched;
+    };
+
+    AbstractGraph m_graphs[ANIMAL_TYPE_COUNT];
+    std::unordered_map<uint64_t, ClusterRoute> m_routes;
+    std::vector<uint64_t> m_missing; // Keys prepareRoutes is searching, and their routes
+    std::vector<ClusterRoute> m_found;
+
+    static void buildGraph(AnimalType type, const World& world, AbstractGraph& graph);
+    static void labelRegions(AnimalType type, const World& world, AbstractGraph& graph);
+    static void findRoute(const AbstractGraph& graph, int from_region, int to_region, RouteSearch& search, ClusterRoute& out_route);
+};
+
+#endif // HIERARCHICAL_PATHFINDER_H
@@ -0,0 +1,35 @@
+#ifndef NOISE_GENERATOR_H
+#define NOISE_GENERATOR_H
+
+#include "core/WFCGenerator.h"
+#include "resources/Biome.h"
+#include <cstdint>
+#include <vector>
+
+// Alternative biome generator: multi-octave value noise for elevation and moisture,
+// mapped to biomes through threshold tables. Rows are sampled in parallel with SIMD
+// inner loops, and every lattice value comes from a counter-based random stream, so
+// the output depends only on the seed.
+class NoiseGenerator {
+public:
+    // compatibility[id] is the bitmask of biomes allowed next to biome id (see WFCGenerator)
+    NoiseGenerator(int width, int height, uint64_t seed, const BiomeMask* compatibility);
+
+    // Fills out_biomes (row-major, width * height) with a BiomeId per tile.
+    // Tiles whose 4-neighbors break the adjacency rules are replaced by a biome
+    // compatible with every other biome.
+    void generate(std::vector<uint8_t>& out_biomes) const;
+
+private:
+    int m_width, m_height;
+    uint64_t m_seed;
+    BiomeMask m_compatibility[BIOME_ID_COUNT];
+
+    // Accumulates all octaves of one noise field for row y into out_row (normalized to [0, 1])
+    void sampleRow(int y, uint64_t stream, float base_frequency, std::vector<float>& lattice, float* out_row) const;
+    float latticeValue(uint64_t stream, int octave, int lattice_x, int lattice_y) const;
+
+    static BiomeId classify(float elevation, float moisture);
+};
+
+#endif // NOISE_GENERATOR_H
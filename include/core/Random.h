@@ -1,8 +1,30 @@
 #ifndef RANDOM_H
 #define RANDOM_H
 
+#include <cstdint>
 #include <random>
 
 extern std::mt19937 rng; // Global random number generator
 
+// --- Counter-based random numbers ---
+// A pure function of (seed, stream, counter): any tile can draw its numbers independently of
+// every other tile, so parallel passes give identical results for any thread count or order.
+
+// SplitMix64 finalizer, a fast bijective 64-bit mixer
+inline uint64_t mixRandomBits(uint64_t value) {
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+inline uint64_t counterRandom(uint64_t seed, uint64_t stream, uint64_t counter) {
+    return mixRandomBits(seed ^ mixRandomBits((stream << 48) ^ counter));
+}
+
+// Uniform float in [0, 1) from the top 24 bits
+inline float counterRandomFloat(uint64_t seed, uint64_t stream, uint64_t counter) {
+    return static_cast<float>(counterRandom(seed, stream, counter) >> 40) * (1.0f / 16777216.0f);
+}
+
 #endif // RANDOM_H
@@ -2,53 +2,73 @@
 #define WFC_GENERATOR_H
 
 #include "resources/Biome.h"
+#include <cstdint>
 #include <vector>
 #include <set>
 #include <random>
 #include <map>
 
-struct WFCCell {
-    std::set<const BiomeType*> possible_biomes;
-    const BiomeType* collapsed_biome = nullptr;
-    bool is_collapsed = false;
-};
+// Set of possible biomes for a cell, one bit per BiomeId
+typedef uint8_t BiomeMask;
+
+const BiomeMask ALL_BIOMES_MASK = static_cast<BiomeMask>((1u << BIOME_ID_COUNT) - 1);
+
+inline BiomeMask biomeBit(BiomeId id) {
+    return static_cast<BiomeMask>(1u << id);
+}
 
 class WFCGenerator {
 public:
     WFCGenerator(int width, int height, std::mt19937& rng);
-    
+
     // Main WFC algorithm
     bool generate();
-    
+
     // Get the final biome assignment for a tile
     const BiomeType* getBiome(int x, int y) const;
-    
+
     // Set initial constraints (seed some cells with specific biomes)
     void setSeed(int x, int y, const BiomeType* biome);
-    
+
     // Get adjacency rules for external use
     const std::map<const BiomeType*, std::set<const BiomeType*>>& getAdjacencyRules() const;
-    
+
+    // Bitmask of biomes allowed next to the given biome
+    BiomeMask getCompatibilityMask(BiomeId id) const;
+
 private:
+    // Marks a cell in m_collapsed that has not been collapsed yet
+    static constexpr uint8_t NOT_COLLAPSED = 0xFF;
+
     int m_width, m_height;
     std::mt19937& m_rng;
-    std::vector<std::vector<WFCCell>> m_grid;
-    
+
+    // Flat grids indexed by y * width + x
+    std::vector<BiomeMask> m_domains;
+    std::vector<uint8_t> m_collapsed;
+
     // Adjacency rules - which biomes can be next to each other
     std::map<const BiomeType*, std::set<const BiomeType*>> m_adjacency_rules;
-    
+
+    // m_compatibility[id]: biomes allowed next to biome id
+    // m_support[mask]: union of m_compatibility over every biome in mask
+    BiomeMask m_compatibility[BIOME_ID_COUNT];
+    BiomeMask m_support[256];
+
+    // Uncollapsed cells bucketed by domain size (entropy). Entries are never removed
+    // eagerly; stale ones (collapsed, or domain size changed) are skipped on pop.
+    std::vector<std::vector<int>> m_entropy_buckets;
+
     // WFC algorithm steps
     void initializeGrid();
     void setupAdjacencyRules();
-    bool findLowestEntropyCell(int& out_x, int& out_y);
-    bool collapseCell(int x, int y);
-    bool propagateConstraints(int x, int y);
-    void updateNeighborConstraints(int x, int y, int nx, int ny);
-    bool isValidNeighbor(const BiomeType* current, const BiomeType* neighbor);
-    
+    bool findLowestEntropyCell(int& out_index);
+    bool collapseCell(int index);
+    bool propagateConstraints(std::vector<int>& to_process);
+
     // Utility functions
     bool isValidCoordinate(int x, int y) const;
-    std::vector<std::pair<int, int>> getNeighbors(int x, int y) const;
+    static int countBiomes(BiomeMask mask);
 };
 
 #endif // WFC_GENERATOR_H
@@ -0,0 +1,88 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <omp.h>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Read-only view of count values in a ScratchArena (range-for, size, indexing like a vector)
+template <typename T>
+struct ScratchSpan {
+    const T* values = nullptr;
+    size_t count = 0;
+
+    const T* begin() const { return values; }
+    const T* end() const { return values + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T& operator[](size_t index) const { return values[index]; }
+};
+
+// Bump allocator for temporary arrays of trivially copyable values. Allocations are carved out
+// of large blocks and released together, either all at once (reset) or back to a mark (rewind).
+// The blocks are kept, so once the arena has grown to a turn's needs it stops allocating.
+// Aligned to a cache line so the arenas of different threads never share one.
+class alignas(64) ScratchArena {
+    public:
+    struct Mark {
+        size_t block;
+        size_t offset;
+    };
+
+    // Uninitialized room for count values of T, valid until the arena is reset or rewound past it
+    template <typename T>
+    T* allocate(size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "ScratchArena only holds trivially copyable values");
+        return static_cast<T*>(allocateBytes(count * sizeof(T), alignof(T)));
+    }
+
+    Mark getMark() const { return {m_block, m_offset}; }
+    void rewind(const Mark& mark) { m_block = mark.block; m_offset = mark.offset; }
+    void reset(); // Releases everything; merges the blocks into one if the arena had to grow
+
+    private:
+    void* allocateBytes(size_t bytes, size_t alignment);
+
+    std::vector<std::unique_ptr<unsigned char[]>> m_blocks;
+    std::vector<size_t> m_block_sizes;
+    size_t m_block = 0;  // Block allocations are carved from
+    size_t m_offset = 0; // Bytes used in that block
+};
+
+// State the worker threads keep from turn to turn. World::update runs a whole turn in one OpenMP
+// parallel region; the runtime keeps its threads alive between regions, so the team is a
+// persistent pool and only this per-thread scratch memory has to be kept here.
+//
+// Code that runs inside the region must be reached by every thread of the team: loops are split
+// with orphaned "omp for", serial steps go in "omp single", and the implicit barriers at their
+// ends separate the phases. Outside a parallel region the same code runs on the calling thread.
+class WorkerPool {
+    public:
+    // Sizes the arenas for the next parallel region and releases last turn's allocations.
+    // Call outside the region.
+    void beginTurn();
+
+    // Arena of the calling thread; only that thread may use it
+    ScratchArena& getThreadArena() { return m_thread_arenas[omp_get_thread_num()]; }
+
+    // Arena for arrays the whole team works on; only to be used inside an "omp single"
+    ScratchArena& getSharedArena() { return m_shared_arena; }
+
+    // Uninitialized array of count values of T, shared by the team. Must be reached by every
+    // thread: one allocates it and the pointer is broadcast to the others.
+    template <typename T>
+    T* allocateShared(size_t count) {
+        T* shared = nullptr;
+        #pragma omp single copyprivate(shared)
+        shared = m_shared_arena.allocate<T>(count);
+        return shared;
+    }
+
+    private:
+    std::vector<ScratchArena> m_thread_arenas;
+    ScratchArena m_shared_arena;
+};
+
+#endif // WORKER_POOL_H
@@ -5,25 +5,119 @@
 #include "EntityManager.h"
 #include "common/AnimalTypes.h"
 #include "resources/Biome.h"
+#include "resources/Terrain.h"
+#include "resources/Resource.h"
 #include "core/WFCGenerator.h"
+#include "core/WorldCache.h"
+#include "core/FlowField.h"
+#include "core/HierarchicalPathfinder.h"
+#include "core/CostScheduler.h"
+#include "core/WorkerPool.h"
 #include <vector>
 #include <memory>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <string>
 
 using SpatialGridCell = std::vector<size_t>;
 
+// Packed per-tile, per-species stat modifiers (see World::getTileModifiers): the speed multiplier
+// in the low byte and the sight multiplier (terrain and forest hindrance combined) in the high byte,
+// both fixed point where TILE_MODIFIER_ONE means 1.0 (range 0 to ~2, steps of 1/128).
+const int TILE_MODIFIER_ONE = 128;
+
+inline float decodeSpeedModifier(uint16_t modifiers) {
+    return (modifiers & 0xFF) * (1.0f / TILE_MODIFIER_ONE);
+}
+
+inline float decodeSightModifier(uint16_t modifiers) {
+    return (modifiers >> 8) * (1.0f / TILE_MODIFIER_ONE);
+}
+
+// Influence fields (see World::mayHaveAnimalsNear): per-species animal counts on a coarse grid
+// of INFLUENCE_CELL_SIZE-tile cells, box-summed so each cell bounds the animals of each species
+// within MAX_SENSE_RADIUS of any tile in it. MAX_SENSE_RADIUS covers the largest sight radius
+// (base sight plus the starvation boost) and every fixed AI query radius.
+const int INFLUENCE_CELL_SIZE = 4;
+const int MAX_SENSE_RADIUS = 10;
+const int INFLUENCE_BOX_RADIUS = (MAX_SENSE_RADIUS + 2 * INFLUENCE_CELL_SIZE - 2) / INFLUENCE_CELL_SIZE; // In cells
+
+// Scent fields kept by World (see World::getScent); only prey species leave scent
+enum ScentField {
+    SCENT_HERBIVORE,
+    SCENT_OMNIVORE,
+    SCENT_FIELD_COUNT
+};
+
+// Which algorithm World::init uses to lay out biomes
+enum class WorldGeneratorType {
+    REGION_WFC,  // Random 15x15 regions with WFC-rule boundary smoothing
+    NOISE_FIELD  // Elevation/moisture value noise mapped through biome thresholds
+};
+
 class World {
     private:
     int width;
     int height;
     int turn_count;
+    uint64_t m_generation_seed; // Seeds the counter-based random streams used by world generation
+    WorldGeneratorType m_generator_type;
+    bool m_has_fixed_seed;                // Otherwise init() draws m_generation_seed from rng
+    std::string m_world_cache_directory;  // Empty disables the generated-world cache
+    int m_ai_decision_budget;             // Max AI decisions per turn, 0 = unlimited (see AISystem)
 
     // --- Data Management ---
     EntityManager m_entityManager; // World now owns the EntityManager
 
-    std::vector<std::vector<Tile>> grid; // Grid for resources/terrain
+    TileLayers m_tiles; // Flat per-tile biome/terrain/resource layers (index = y * width + x)
+
+    // Derived per-species terrain caches, rebuilt whenever terrain changes
+    std::vector<uint64_t> m_passable[ANIMAL_TYPE_COUNT]; // One bit per tile (tile index order), 1 = can enter
+    std::vector<uint16_t> m_tile_modifiers;              // [tile_index * ANIMAL_TYPE_COUNT + type], packed speed/sight
+
+    // Active set for resource regrowth: indices of resource tiles below max_amount, with a
+    // per-tile membership flag. Only these tiles are visited by updateResources.
+    std::vector<uint32_t> m_regrowing_tiles;
+    std::vector<uint8_t> m_tile_regrowing;
+
+    // Per-tile regrowth rate and cap (0 for tiles without a resource), contiguous so a dense
+    // regrowth sweep is a SIMD kernel when most tiles are regrowing
+    std::vector<float> m_tile_regrowth_rate;
+    std::vector<float> m_tile_max_amount;
+
+    // Max-food pyramid for pruned food searches. Level 0 holds each tile's food value
+    // (resource amount * nutritional value); every level above holds the maximum over 2x2
+    // blocks of the level below, up to a single block covering the whole map.
+    std::vector<std::vector<float>> m_food_pyramid;
+    std::vector<int> m_food_pyramid_widths;         // Blocks per row on each level
+    float m_resource_nutrition[RESOURCE_ID_COUNT];  // Nutritional value by ResourceId (0 for none)
     std::vector<std::vector<SpatialGridCell>> spatial_grid; // Stores entity IDs for spatial queries
+    std::vector<int> spatial_grid_population; // Living entities per cell and species, filled with the grid
+    // Per spatial grid cell: last turn an entity entered, left, was born or died there, or a food
+    // tile in it ran out. Lets the AI keep decisions whose surroundings did not change.
+    std::vector<int> m_cell_change_turns;
+
+    // Influence fields, rebuilt with the spatial grid: [cell * ANIMAL_TYPE_COUNT + type]
+    int influence_grid_width;
+    int influence_grid_height;
+    std::vector<int> m_influence_counts;    // Living animals per cell
+    std::vector<int> m_influence_row_sums;  // Horizontal pass of the box sum
+    std::vector<int> m_influence_field;     // Animals in the (2 * INFLUENCE_BOX_RADIUS + 1)² cells around each cell
+
+    // Prey scent per tile, diffused and decayed every turn (tile index order)
+    std::vector<float> m_scent[SCENT_FIELD_COUNT];
+    std::vector<float> m_scent_next;                        // Stencil output, swapped with the field
+    std::vector<int> m_scent_deposits[SCENT_FIELD_COUNT];   // Animals standing on each tile this turn
+
+    FlowFieldCache m_flow_fields; // Shared pathing fields per (species, goal region), see MovementSystem
+    HierarchicalPathfinder m_pathfinder; // Cluster routes for distant goals, see MovementSystem
+
+    // Per-thread load of the cost-scheduled system loops, accumulated since init()
+    LoopThreadStats m_ai_thread_stats;
+    LoopThreadStats m_metabolism_thread_stats;
+
+    WorkerPool m_worker_pool; // Scratch memory of the threads running update(), see WorkerPool
 
     // Spatial Grid Properties
     int spatial_grid_cell_size;
@@ -32,16 +126,43 @@ class World {
 
     // --- Private Helper Functions ---
     // These will be rewritten or replaced by Systems later
+    // The per-turn helpers called from update() are reached by every thread of its parallel
+    // region (see WorkerPool); outside a region they run on the calling thread.
     void updateResources();
+    void rebuildRegrowingTiles(); // Recomputes the regrowth active set from the resource layers
+    void regrowAllTiles();        // Dense regrowth sweep over every tile
+    void regrowActiveTiles();     // Sparse regrowth of the active set (serial)
+    void rebuildFoodPyramid();                 // Recomputes every pyramid level from the resource layers
+    void updateFoodPyramid(size_t tile_index); // Refreshes one tile's food value and its ancestor blocks
     void updateSpatialGrid();
+    void fillSpatialGrid();       // Sorts the living entities into the grid cells (serial)
+    void markCellChange(int x, int y);            // Stamps the spatial cell of a tile with this turn
+    void markEntityCellChanges(); // Cells of entities that moved cells, died or were just born this turn
+    void updateInfluenceFields(); // Scatter of living animals into the coarse grid, then a box sum
+    void updateScentFields();     // Deposits prey scent, then one diffusion/decay stencil step per field
     void generateBiomes(); // <-- New terrain generation function
+    void generateNoiseBiomes(); // Alternative generator, see NoiseGenerator
     void seedResources();  // <-- New resource seeding function
+    bool loadCachedWorld();       // Fills the tiles from the world cache, false on a miss
+    void saveCachedWorld() const;
+    WorldCacheKey getWorldCacheKey() const;
+    void rebuildTerrainCaches();                  // Recomputes every per-tile terrain-derived cache
+    void updateTerrainCaches(size_t tile_index);  // Recomputes the caches of a single tile
     int calculateOptimalCellSize() const; // <-- NEW: Calculate optimal spatial grid cell size
 
     public:
     World(int w, int h, int cell_size = 0); // 0 = auto-calculate optimal size
 
     void init(int initial_herbivores, int initial_carnivores, int initial_omnivores);
+    void setGeneratorType(WorldGeneratorType type) { m_generator_type = type; } // Takes effect on the next init()
+    // Fixes the seed for terrain/resource generation so a world can be replayed (and cached)
+    void setGenerationSeed(uint64_t seed) { m_generation_seed = seed; m_has_fixed_seed = true; }
+    // Directory for generated-world cache files; init() loads a matching file instead of generating
+    void setWorldCacheDirectory(const std::string& directory) { m_world_cache_directory = directory; }
+    // Caps AI decisions per turn (0 = unlimited). Entities that are threatened or near other
+    // animals always decide; only the re-evaluation of stable wanderers is deferred.
+    void setAIDecisionBudget(int budget) { m_ai_decision_budget = budget; }
+    int getAIDecisionBudget() const { return m_ai_decision_budget; }
     void update(); // This will be the home of our System calls
     bool isEcosystemCollapsed() const;
 
@@ -57,14 +178,96 @@ class World {
     */
     // A new version will be created that returns entity IDs.
 
-    Tile& getTile(int x, int y);
-    const Tile& getTile(int x, int y) const;
+    // Compatibility view of one tile with resolved type pointers (default Tile when out of bounds).
+    // Hot paths should use the per-layer accessors below instead.
+    Tile getTile(int x, int y) const;
+
+    // --- Tile Layer Accessors ---
+    // No bounds checks: callers must pass coordinates inside the world.
+    size_t getTileIndex(int x, int y) const { return static_cast<size_t>(y) * width + x; }
+    const TileLayers& getTileLayers() const { return m_tiles; }
+    ResourceId getResourceId(int x, int y) const { return static_cast<ResourceId>(m_tiles.resource_ids[getTileIndex(x, y)]); }
+    float getResourceAmount(int x, int y) const { return m_tiles.resource_amounts[getTileIndex(x, y)]; }
+    const TerrainType* getTerrainAt(int x, int y) const { return ALL_TERRAINS[m_tiles.terrain_ids[getTileIndex(x, y)]]; }
+    const BiomeType* getBiomeAt(int x, int y) const { return ALL_BIOMES[m_tiles.biome_ids[getTileIndex(x, y)]]; }
+
+    // Removes up to amount_requested from the tile's resource, returns the amount actually consumed.
+    // Adds the tile to the regrowth active set; not thread-safe (ActionSystem runs serially).
+    float consumeResource(int x, int y, float amount_requested);
+
+    // --- Food Pyramid ---
+    // Upper bounds on food value for area searches (see AISystem::findBestFood).
+    // Level l has blocks of 2^l x 2^l tiles; level 0 is the food value of a single tile.
+    int getFoodPyramidLevelCount() const { return static_cast<int>(m_food_pyramid.size()); }
+    // Maximum food value inside block (block_x, block_y) of the level; no bounds checks
+    float getMaxFoodInBlock(int level, int block_x, int block_y) const {
+        return m_food_pyramid[level][static_cast<size_t>(block_y) * m_food_pyramid_widths[level] + block_x];
+    }
+
+    // Whether an animal of the given species may enter the tile: a single bit test on a
+    // precomputed per-species bitmap (equivalent to Tile::canMove)
+    bool canMove(int x, int y, AnimalType type) const {
+        size_t index = getTileIndex(x, y);
+        return (m_passable[static_cast<int>(type)][index >> 6] >> (index & 63)) & 1;
+    }
+
+    // Speed and sight multipliers for an animal of the given species standing on the tile,
+    // decoded with decodeSpeedModifier / decodeSightModifier
+    uint16_t getTileModifiers(int x, int y, AnimalType type) const {
+        return m_tile_modifiers[getTileIndex(x, y) * ANIMAL_TYPE_COUNT + static_cast<int>(type)];
+    }
+
+    // Changes a tile's terrain and keeps the derived terrain caches in sync
+    void setTerrain(int x, int y, TerrainId terrain);
     
     // Allow Systems to access the entity manager
     const EntityManager& getEntityManager() const { return m_entityManager; }
     EntityManager& getEntityManager() { return m_entityManager; }
 
-    std::vector<size_t> getAnimalsNear(const EntityManager& data, int x, int y, int radius, AnimalType target_type) const;
+    // Living animals of the type within radius of (x, y). The ids are kept in arena (normally
+    // the calling thread's, see WorkerPool) until it is rewound.
+    ScratchSpan<size_t> getAnimalsNear(const EntityManager& data, int x, int y, int radius, AnimalType target_type, ScratchArena& arena) const;
+
+    // Conservative pre-check for getAnimalsNear: false only if fewer than min_count animals of the
+    // type can be within radius of (x, y), answered from the influence fields in O(1). Radii above
+    // MAX_SENSE_RADIUS fall back to summing the spatial grid cells the query would scan. Matches
+    // the spatial grid snapshot, so it is exact for queries made before entities move (the AI phase).
+    bool mayHaveAnimalsNear(int x, int y, int radius, AnimalType type, int min_count = 1) const {
+        if (radius > MAX_SENSE_RADIUS) return countAnimalsInCells(x, y, radius, type) >= min_count;
+        size_t cell = static_cast<size_t>(y / INFLUENCE_CELL_SIZE) * influence_grid_width + x / INFLUENCE_CELL_SIZE;
+        return m_influence_field[cell * ANIMAL_TYPE_COUNT + static_cast<int>(type)] >= min_count;
+    }
+
+    // Animals of the type in the spatial grid cells overlapping the square of the given radius
+    // around (x, y): an upper bound for wide queries, without visiting the entities
+    int countAnimalsInCells(int x, int y, int radius, AnimalType type) const;
+
+    // True if any spatial grid cell overlapping the square of the given radius around (x, y) saw an
+    // entity enter, leave, be born or die, or a food tile run out, at or after the given turn
+    bool hasAreaChangedSince(int x, int y, int radius, int turn) const;
+
+    // Flow fields and cluster routes for movement toward goals; prepared before MovementSystem::run each turn
+    const FlowFieldCache& getFlowFields() const { return m_flow_fields; }
+    FlowFieldCache& getFlowFields() { return m_flow_fields; }
+    const HierarchicalPathfinder& getPathfinder() const { return m_pathfinder; }
+    HierarchicalPathfinder& getPathfinder() { return m_pathfinder; }
+    const LoopThreadStats& getAIThreadStats() const { return m_ai_thread_stats; }
+    const LoopThreadStats& getMetabolismThreadStats() const { return m_metabolism_thread_stats; }
+
+    // Prey scent on a tile; no bounds checks
+    float getScent(int x, int y, ScentField field) const { return m_scent[field][getTileIndex(x, y)]; }
+
+    // Appends the IDs of every entity stored in spatial grid cells overlapping the tile rectangle
+    // [min_x, max_x] x [min_y, max_y]. No per-entity filtering is done; callers apply their own tests.
+    void getEntitiesInArea(int min_x, int min_y, int max_x, int max_y, std::vector<size_t>& out_ids) const;
+
+    // Spatial grid layout and per-cell population, for aggregate views (e.g. zoomed-out density rendering)
+    int getSpatialGridWidth() const { return spatial_grid_width; }
+    int getSpatialGridHeight() const { return spatial_grid_height; }
+    int getSpatialGridCellSize() const { return spatial_grid_cell_size; }
+    int getSpatialCellPopulation(int cell_x, int cell_y, AnimalType type) const {
+        return spatial_grid_population[(cell_y * spatial_grid_width + cell_x) * ANIMAL_TYPE_COUNT + static_cast<int>(type)];
+    }
 
 };
 
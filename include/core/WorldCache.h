@@ -0,0 +1,37 @@
+#ifndef WORLD_CACHE_H
+#define WORLD_CACHE_H
+
+#include "resources/Tile.h"
+#include <cstdint>
+#include <string>
+
+// Everything a generated world depends on. A cached file is only used when all fields match.
+struct WorldCacheKey {
+    uint64_t seed;
+    int32_t width;
+    int32_t height;
+    int32_t generator_type;
+};
+
+// Bump whenever generation code changes its output for the same key, to invalidate old caches
+const uint32_t WORLD_GENERATOR_VERSION = 1;
+
+// Binary cache of generated worlds.
+//
+// File layout (native byte order): a 64-byte header (magic, format and generator versions, key),
+// then the biome, terrain and resource ID layers as raw bytes, then the resource amounts as
+// floats starting at a 4-byte aligned offset. Layers are contiguous and at fixed offsets, so
+// the file can be read with one call per layer (or memory mapped).
+namespace WorldCache {
+    // Cache file for a key inside the given directory
+    std::string getCachePath(const std::string& directory, const WorldCacheKey& key);
+
+    // Returns false if the file is missing, truncated, from another format/generator version
+    // or for a different key; out_layers is only valid when this returns true.
+    // Regrowth timers are not stored and are reset to zero on load.
+    bool load(const std::string& path, const WorldCacheKey& key, TileLayers& out_layers);
+
+    bool save(const std::string& path, const WorldCacheKey& key, const TileLayers& layers);
+}
+
+#endif // WORLD_CACHE_H
@@ -3,8 +3,11 @@
 
 #include <SFML/Graphics.hpp>
 #include <cstddef> // For size_t
+#include <cstdint>
+#include <vector>
 
 class EntityManager; // Forward declaration
+class World;         // Forward declaration
 
 enum class CameraMode {
     NORMAL,
@@ -15,23 +18,33 @@ class Camera {
 public:
     Camera(unsigned int window_width, unsigned int window_height, int world_width, int world_height, int tile_size);
 
-    void handleEvent(const sf::Event& event, sf::RenderWindow& window, const EntityManager* entityManager = nullptr);
+    void handleEvent(const sf::Event& event, sf::RenderWindow& window, const World* world = nullptr);
     void update(float delta_time);
     void updateFollowMode(const EntityManager* entityManager);
+    // Cleanup reorders the entities every turn: selections are held by uid and their indices
+    // re-found here (once per frame, before they are read)
+    void refreshSelection(const EntityManager* entityManager);
     void reset();
     void pan(const sf::Vector2f& delta);
 
     const sf::View& getView() const;
+    float getZoomLevel() const; // World pixels per screen pixel (larger = further out)
     bool isDragging() const;
     
     // Entity selection methods
     size_t getSelectedEntity() const;
     bool hasSelectedEntity() const;
     void clearSelection();
+
+    // Box selection (right mouse drag): all entities inside the dragged rectangle
+    bool isBoxSelecting() const;
+    sf::FloatRect getBoxSelectionRect() const; // In world pixels
+    const std::vector<size_t>& getBoxSelection() const;
+    void clearBoxSelection();
     
     // Camera mode methods
     CameraMode getMode() const;
-    void setFollowTarget(size_t entity_id);
+    void setFollowTarget(size_t entity_id, uint64_t entity_uid);
 
 private:
     void initialize(unsigned int window_width, unsigned int window_height, int world_width, int world_height, int tile_size);
@@ -39,7 +52,8 @@ private:
     void constrain();
     void smoothZoom(float delta_time);
     void smoothPan(float delta_time);
-    size_t findEntityAtPosition(const sf::Vector2f& world_pos, const EntityManager* entityManager) const;
+    size_t findEntityAtPosition(const sf::Vector2f& world_pos, const World* world) const;
+    std::vector<size_t> findEntitiesInRect(const sf::FloatRect& world_rect, const World* world) const;
     sf::Vector2f calculateFollowPosition(const EntityManager* entityManager) const;
 
     sf::View m_view;
@@ -62,8 +76,16 @@ private:
     
     // Entity selection state
     size_t m_selected_entity;
+    uint64_t m_selected_uid;
     bool m_has_selection;
     static const size_t INVALID_ENTITY = static_cast<size_t>(-1);
+
+    // Box selection state
+    bool m_is_box_selecting;
+    sf::Vector2f m_box_start;
+    sf::Vector2f m_box_end;
+    std::vector<size_t> m_box_selection;
+    std::vector<uint64_t> m_box_selection_uids; // Parallel to m_box_selection
 };
 
 #endif // CAMERA_H
@@ -6,6 +6,7 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <vector>
 #include "core/World.h"
 #include "core/EntityManager.h"
 #include "resources/Resource.h"
@@ -22,16 +23,16 @@ public:
 
     void init(unsigned int window_width, unsigned int window_height, int world_width, int world_height, int tile_size, const std::string& title);
     bool isOpen() const;
-    void handleEvents(const EntityManager* entityManager = nullptr);
+    void handleEvents(const World* world = nullptr);
     void clear(const sf::Color& color = sf::Color::Black);
     void display();
     void update(float delta_time, const EntityManager* entityManager = nullptr);
 
     void drawWorld(const World& world);
-    void drawEntities(const EntityManager& entityManager, float animation_progress);
+    void drawEntities(const World& world, float animation_progress);
     void drawSelectionIndicator(const EntityManager& entityManager, float animation_progress);
     void drawUI(const World& world, bool is_paused);
-    void drawEntityDetailPanel(const EntityManager& entityManager);
+    void drawEntityDetailPanel(const World& world);
     void drawSimulationEndedMessage();
     void drawCursor();
     
@@ -42,6 +43,13 @@ private:
     // Helper method for view frustum culling
     sf::FloatRect getVisibleBounds() const;
 
+    // Level-of-detail: when zoomed out far enough, population is drawn as a density heatmap
+    bool isHeatmapLODActive() const;
+    void drawPopulationHeatmap(const World& world);
+
+    // Box selection: drag rectangle and markers on the selected entities
+    void drawBoxSelection(const EntityManager& entityManager, float eased_progress);
+
     sf::RenderWindow m_window;
     int m_tile_size;
     sf::Texture m_empty_tile_texture;
@@ -53,6 +61,14 @@ private:
 
     std::unique_ptr<Camera> m_camera;
     std::unique_ptr<UIManager> m_ui_manager;
+
+    // Reused each frame to collect candidate entities from the spatial grid
+    std::vector<size_t> m_visible_entities;
+
+    // Density heatmap (one texel per spatial grid cell), refreshed once per simulation turn
+    sf::Texture m_heatmap_texture;
+    std::vector<sf::Uint8> m_heatmap_pixels;
+    int m_heatmap_turn;
 };
 
 #endif // GRAPHICS_RENDERER_H
@@ -13,7 +13,7 @@ public:
     UIManager();
     bool loadAssets();
     void drawUI(sf::RenderWindow& window, const World& world, bool is_paused);
-    void drawEntityDetailPanel(sf::RenderWindow& window, const EntityManager& entityManager, const Camera& camera);
+    void drawEntityDetailPanel(sf::RenderWindow& window, const World& world, const Camera& camera);
     void drawSimulationEndedMessage(sf::RenderWindow& window);
     void drawCursor(sf::RenderWindow& window);
 
@@ -23,11 +23,15 @@ private:
     sf::Sprite m_cursor_sprite;
     std::map<AnimalType, sf::Texture> m_animal_textures;
     
-    // Performance optimization: cache for entity detail panel
-    mutable size_t m_last_selected_entity;
-    mutable std::string m_cached_panel_content;
+    // Performance optimization: the entity detail panel is laid out into a texture and only
+    // rebuilt when the selection or the simulation turn changes; every frame just blits it
+    sf::RenderTexture m_panel_texture;
+    bool m_panel_texture_ready;
+    size_t m_last_selected_entity;
+    int m_last_panel_turn;
     
     // Helper methods for entity detail panel
+    void renderEntityDetailPanel(const EntityManager& entityManager, size_t selected_id);
     std::string getAnimalTypeString(AnimalType type);
     std::string getAIStateString(AIState state);
     std::string getHealthCondition(float health, float max_health);
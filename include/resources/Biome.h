@@ -3,6 +3,7 @@
 
 #include "resources/Resource.h"
 #include <SFML/Graphics/Color.hpp>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
@@ -10,9 +11,21 @@
 // Forward declare TerrainType to avoid include loop
 struct TerrainType;
 
+// Compact biome identifiers, used as bit positions in WFC domain masks
+enum BiomeId : uint8_t {
+    BIOME_ID_WATER = 0,
+    BIOME_ID_BARREN,
+    BIOME_ID_ROCKY,
+    BIOME_ID_GRASSLAND,
+    BIOME_ID_FOREST,
+    BIOME_ID_FERTILE,
+    BIOME_ID_COUNT
+};
+
 // Defines the properties of a specific biome
 struct BiomeType {
     std::string name;
+    BiomeId id;
 
     // Defines which terrains can appear in this biome and their spawn probability.
     std::map<const TerrainType*, float> terrain_distribution;
@@ -32,4 +45,7 @@ extern const BiomeType BIOME_GRASSLAND;
 extern const BiomeType BIOME_FOREST;
 extern const BiomeType BIOME_FERTILE;
 
+// All biomes indexed by BiomeId
+extern const BiomeType* const ALL_BIOMES[BIOME_ID_COUNT];
+
 #endif // BIOME_H
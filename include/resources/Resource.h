@@ -1,11 +1,22 @@
 #ifndef RESOURCE_H
 #define RESOURCE_H
 
+#include <cstdint>
 #include <string>
 
+// Compact resource identifiers for tile storage; 0 means "no resource"
+enum ResourceId : uint8_t {
+    RESOURCE_ID_NONE = 0,
+    RESOURCE_ID_GRASS,
+    RESOURCE_ID_BERRIES,
+    RESOURCE_ID_BUSH,
+    RESOURCE_ID_COUNT
+};
+
 // Struct to define a type of resource (like Grass)
 struct ResourceType {
     std::string name;
+    ResourceId id;
     float max_amount; // Maximum amount of resource on a tile
     float regrowth_rate; // Amount that regrows per turn
     float nutritional_value; // Nutritional value of the resource
@@ -16,4 +27,7 @@ extern const ResourceType RESOURCE_GRASS;
 extern const ResourceType RESOURCE_BERRIES;
 extern const ResourceType RESOURCE_BUSH;
 
+// All resources indexed by ResourceId (RESOURCE_ID_NONE maps to nullptr)
+extern const ResourceType* const ALL_RESOURCES[RESOURCE_ID_COUNT];
+
 #endif // RESOURCE_H
@@ -3,12 +3,22 @@
 
 #include "common/AnimalTypes.h"
 #include <SFML/Graphics/Color.hpp>
+#include <cstdint>
 #include <string>
 #include <set>
 
+// Compact terrain identifiers for tile storage
+enum TerrainId : uint8_t {
+    TERRAIN_ID_NORMAL = 0,
+    TERRAIN_ID_WATER,
+    TERRAIN_ID_ROCKY,
+    TERRAIN_ID_COUNT
+};
+
 // Struct to define a type of terrain
 struct TerrainType {
     std::string name;
+    TerrainId id;
     float speed_modifier;    // Multiplier for entity speed (0.5 = half speed, 1.0 = normal)
     float sight_modifier;    // Multiplier for entity sight radius
     std::set<AnimalType> allowed_types; // Empty set means all types allowed
@@ -21,4 +31,7 @@ extern const TerrainType TERRAIN_NORMAL;
 extern const TerrainType TERRAIN_WATER;
 extern const TerrainType TERRAIN_ROCKY;
 
+// All terrains indexed by TerrainId
+extern const TerrainType* const ALL_TERRAINS[TERRAIN_ID_COUNT];
+
 #endif // TERRAIN_H
@@ -3,6 +3,7 @@
 
 #include "Resource.h"
 #include "common/AnimalTypes.h"
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -13,6 +14,27 @@ struct BiomeType;
 // Forward declare TerrainType to avoid include loop with Terrain.h  
 struct TerrainType;
 
+// Storage for the whole tile grid as flat parallel arrays in row-major order
+// (index = y * width + x). IDs index ALL_BIOMES / ALL_TERRAINS / ALL_RESOURCES,
+// so a tile costs 11 bytes instead of a 40-byte pointer-heavy Tile.
+struct TileLayers {
+    std::vector<uint8_t> biome_ids;
+    std::vector<uint8_t> terrain_ids;
+    std::vector<uint8_t> resource_ids;
+    std::vector<float>   resource_amounts;
+    std::vector<int>     regrowth_timers; // How many turns until regrowth
+
+    void resize(size_t tile_count) {
+        biome_ids.assign(tile_count, 0);
+        terrain_ids.assign(tile_count, 0);
+        resource_ids.assign(tile_count, 0);
+        resource_amounts.assign(tile_count, 0.0f);
+        regrowth_timers.assign(tile_count, 0);
+    }
+};
+
+// A single tile with resolved type pointers. The World no longer stores Tiles;
+// World::getTile builds one from TileLayers as a read-only convenience view.
 struct Tile {
     // --- Animal Information ---
     // Don't store the Animal* here directly because the World owns them.
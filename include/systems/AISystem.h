@@ -3,10 +3,20 @@
 
 #include "core/EntityManager.h"
 #include "core/World.h"
+#include "core/CostScheduler.h"
 
 namespace AISystem {
-    // Function to run the AI decision-making logic for all entities
-    void run(EntityManager& data, const World& world);
+    // Function to run the AI decision-making logic for all entities. Reached by every thread of
+    // the turn's parallel region; decisions are spread over the threads by estimated cost, with
+    // neighbour queries kept in the pool's thread arenas. Per-thread busy/idle times are added
+    // to thread_stats if given.
+    void run(EntityManager& data, const World& world, WorkerPool& pool, LoopThreadStats* thread_stats = nullptr);
+
+    // Finds the food tile with the best energy-per-distance ratio within radius of (x, y), with
+    // ties going to the first tile in row-major order. Walks the disc outward (DiscOffsets) until
+    // the world's max-food pyramid shows no farther tile can win. Radii are capped at
+    // DiscOffsets::MAX_RADIUS, well beyond any sight radius. Returns false if nothing is in range.
+    bool findBestFood(const World& world, int x, int y, int radius, int& out_x, int& out_y);
 }
 
 #endif // AI_SYSTEM_H
@@ -4,7 +4,8 @@
 #include "core/EntityManager.h"
 
 namespace AnimationSystem {
-    // Function to capture the current positions as the previous positions
+    // Function to capture the current positions as the previous positions; reached by every
+    // thread of the turn's parallel region (see WorkerPool)
     void capturePreviousPositions(EntityManager& data);
 }
 
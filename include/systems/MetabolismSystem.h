@@ -3,11 +3,13 @@
 
 #include "core/EntityManager.h"
 #include "core/World.h"
+#include "core/CostScheduler.h"
 #include <cstddef>
 
 namespace MetabolismSystem {
-    // Function to run the metabolic logic for all entities
-    void run(EntityManager& data, const World& world);
+    // Function to run the metabolic logic for all entities. Reached by every thread of the turn's
+    // parallel region (see WorkerPool); per-thread busy/idle times are added to thread_stats if given.
+    void run(EntityManager& data, const World& world, WorkerPool& pool, LoopThreadStats* thread_stats = nullptr);
 
     // Helper function for applying damage to a specific entity ID
     void applyDamage(EntityManager& data, size_t entity_id, float amount);
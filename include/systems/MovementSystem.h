@@ -3,12 +3,32 @@
 
 #include "core/EntityManager.h"
 #include "core/World.h"
+#include "core/WorkerPool.h"
 #include <cstddef>
 
 namespace MovementSystem {
-    // Function to run the movement logic for all entities
+    // Function to run the movement logic for all entities; reached by every thread of the
+    // turn's parallel region (see WorkerPool)
     void run(EntityManager& data, const World& world);
 
+    // Prepass before run: prepares the region routes (HPA*) for distant goals and the flow fields
+    // for blocked ones, so run only reads the world's pathing caches. Reached by every thread of
+    // the turn's parallel region; the key lists live in the pool's shared arena.
+    void preparePathing(const EntityManager& data, World& world, WorkerPool& pool);
+
+    // Tile an entity moving towards a target is heading for this turn (for fleeing entities, the
+    // flee goal); false if it has none
+    bool getMoveGoal(const EntityManager& data, size_t entity_id, const World& world, int& out_x, int& out_y);
+
+    // Where an entity fleeing from (threat_x, threat_y) runs to when terrain blocks its first
+    // step away: the farthest passable tile up to FLEE_GOAL_DISTANCE away in the flee direction.
+    // False if the way is open (it just steps away) or no such tile exists.
+    bool getFleeGoal(const EntityManager& data, size_t entity_id, const World& world, int threat_x, int threat_y, int& out_x, int& out_y);
+
+    // Where an entity at (x, y) steers for a goal: the next cluster route waypoint for distant
+    // goals with a prepared route, otherwise the goal itself
+    void getSteeringGoal(const World& world, AnimalType type, int x, int y, int goal_x, int goal_y, int& out_x, int& out_y);
+
     // Helper functions for movement logic operating directly on EntityManager data
     void moveTowards(EntityManager& data, size_t entity_id, const World& world, int target_x_coord, int target_y_coord);
     void moveAwayFrom(EntityManager& data, size_t entity_id, const World& world, int target_x_coord, int target_y_coord);
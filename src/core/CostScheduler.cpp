@@ -0,0 +1,51 @@
+#include "core/CostScheduler.h"
+#include <algorithm>
+
+void LoopThreadStats::reset() {
+    std::fill(busy_ms.begin(), busy_ms.end(), 0.0);
+    std::fill(idle_ms.begin(), idle_ms.end(), 0.0);
+}
+
+double LoopThreadStats::getTotalBusyMs() const {
+    double total = 0.0;
+    for (double ms : busy_ms) total += ms;
+    return total;
+}
+
+double LoopThreadStats::getTotalIdleMs() const {
+    double total = 0.0;
+    for (double ms : idle_ms) total += ms;
+    return total;
+}
+
+double LoopThreadStats::getIdleFraction() const {
+    double busy = getTotalBusyMs();
+    double idle = getTotalIdleMs();
+    return (busy + idle > 0.0) ? idle / (busy + idle) : 0.0;
+}
+
+namespace CostScheduler {
+
+    int buildChunks(const float* costs, size_t item_count, int chunk_count, size_t* out_bounds) {
+        chunk_count = static_cast<int>(std::min<size_t>(std::max(chunk_count, 1), std::max<size_t>(item_count, 1)));
+
+        double total_cost = 0.0;
+        for (size_t k = 0; k < item_count; ++k) total_cost += costs[k];
+
+        // Cut after the item whose running cost first reaches the next multiple of the target
+        int bound_count = 0;
+        out_bounds[bound_count++] = 0;
+        double target = total_cost / chunk_count;
+        double running_cost = 0.0;
+        for (size_t k = 0; k < item_count && bound_count < chunk_count; ++k) {
+            running_cost += costs[k];
+            if (running_cost >= target * bound_count) {
+                out_bounds[bound_count++] = k + 1;
+            }
+        }
+        if (out_bounds[bound_count - 1] != item_count) {
+            out_bounds[bound_count++] = item_count;
+        }
+        return bound_count - 1;
+    }
+}
@@ -0,0 +1,46 @@
+#include "core/DiscOffsets.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    struct DiscOffsetTable {
+        std::vector<DiscOffset> offsets;
+        size_t counts[DiscOffsets::MAX_RADIUS + 1]; // Prefix length for each integer radius
+
+        DiscOffsetTable() {
+            const int max_radius_sq = DiscOffsets::MAX_RADIUS * DiscOffsets::MAX_RADIUS;
+            for (int dy = -DiscOffsets::MAX_RADIUS; dy <= DiscOffsets::MAX_RADIUS; ++dy) {
+                for (int dx = -DiscOffsets::MAX_RADIUS; dx <= DiscOffsets::MAX_RADIUS; ++dx) {
+                    int distance_sq = dx * dx + dy * dy;
+                    if (distance_sq > max_radius_sq) continue;
+                    offsets.push_back({static_cast<int16_t>(dx), static_cast<int16_t>(dy), distance_sq, std::sqrt(float(distance_sq))});
+                }
+            }
+
+            // Stable: offsets were generated in row-major order, which is kept among equal distances
+            std::stable_sort(offsets.begin(), offsets.end(), [](const DiscOffset& a, const DiscOffset& b) {
+                return a.distance_sq < b.distance_sq;
+            });
+
+            size_t count = 0;
+            for (int radius = 0; radius <= DiscOffsets::MAX_RADIUS; ++radius) {
+                while (count < offsets.size() && offsets[count].distance_sq <= radius * radius) ++count;
+                counts[radius] = count;
+            }
+        }
+    };
+
+    const DiscOffsetTable& getTable() {
+        static const DiscOffsetTable table; // Initialized once, even with concurrent first calls
+        return table;
+    }
+}
+
+const std::vector<DiscOffset>& DiscOffsets::getOffsets() {
+    return getTable().offsets;
+}
+
+size_t DiscOffsets::getCount(int radius) {
+    if (radius < 0) return 0;
+    return getTable().counts[std::min(radius, MAX_RADIUS)];
+}
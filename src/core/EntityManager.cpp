@@ -3,19 +3,52 @@
 #include "common/AnimalTypes.h" // Needed for AnimalType enum used in createEntity
 #include "core/Random.h"
 #include <algorithm>
-#include <cmath> // For std::abs in destroyEntity (if used there, not currently)
+#include <iterator> // For std::begin/std::end on the census arrays
 #include <random> // <-- Include random for the definition
 #include <vector> // Needed for vector operations
 
 
-EntityManager::EntityManager() : num_entities(0) {}
+EntityManager::EntityManager() : num_entities(0), m_next_uid(0) {
+    std::fill(std::begin(m_alive_count), std::end(m_alive_count), 0);
+    std::fill(std::begin(m_species_begin), std::end(m_species_begin), 0);
+    beginTurn();
+}
 
 size_t EntityManager::getEntityCount() const {
     return num_entities;
 }
 
+int EntityManager::getTotalAliveCount() const {
+    int total = 0;
+    for (int count : m_alive_count) total += count;
+    return total;
+}
+
+void EntityManager::beginTurn() {
+    std::fill(std::begin(m_births_this_turn), std::end(m_births_this_turn), 0);
+    std::fill(std::begin(m_deaths_this_turn), std::end(m_deaths_this_turn), 0);
+}
+
+void EntityManager::recordBirth(AnimalType type) {
+    m_alive_count[static_cast<int>(type)]++;
+    m_births_this_turn[static_cast<int>(type)]++;
+}
+
+void EntityManager::markDead(size_t index) {
+    if (index >= num_entities || !is_alive[index]) return;
+
+    is_alive[index] = false;
+    int t = static_cast<int>(type[index]);
+    // Several threads may mark different entities of the same species at once
+    #pragma omp atomic
+    m_alive_count[t]--;
+    #pragma omp atomic
+    m_deaths_this_turn[t]++;
+}
+
 void EntityManager::clear() {
     is_alive.clear();
+    uid.clear();
     x.clear();
     y.clear();
     prev_x.clear();
@@ -25,6 +58,7 @@ void EntityManager::clear() {
     target_id.clear();
     type.clear();
     state.clear();
+    last_decision_turn.clear();
     health.clear();
     max_health.clear();
     base_max_health.clear();
@@ -45,12 +79,16 @@ void EntityManager::clear() {
     minimum_nutritional_value.clear();
 
     num_entities = 0;
+    std::fill(std::begin(m_alive_count), std::end(m_alive_count), 0);
+    std::fill(std::begin(m_species_begin), std::end(m_species_begin), 0);
+    beginTurn();
 }
 
 size_t EntityManager::createEntity() {
     size_t id = num_entities;
 
     is_alive.push_back(true);
+    uid.push_back(m_next_uid++);
     x.push_back(0);
     y.push_back(0);
     prev_x.push_back(0);
@@ -59,6 +97,7 @@ size_t EntityManager::createEntity() {
     target_y.push_back(-1);
     target_id.push_back(-1); // Use -1 or a large value for "no target"
     state.push_back(AIState::WANDERING);
+    last_decision_turn.push_back(NO_DECISION_TURN);
     health.push_back(0.0f);
     max_health.push_back(0.0f);
     base_max_health.push_back(0.0f);
@@ -83,81 +122,12 @@ size_t EntityManager::createEntity() {
     return id;
 }
 
-void EntityManager::destroyEntity(size_t index) {
-    if (num_entities == 0 || index >= num_entities) return;
-
-    size_t last_index = num_entities - 1;
-
-    if (index != last_index) {
-        // Fast removal: swap the last element with the one to be removed
-        is_alive[index] = is_alive[last_index];
-        x[index] = x[last_index];
-        y[index] = y[last_index];
-        prev_x[index] = prev_x[last_index];
-        prev_y[index] = prev_y[last_index];
-        target_x[index] = target_x[last_index];
-        target_y[index] = target_y[last_index];
-        target_id[index] = target_id[last_index];
-        type[index] = type[last_index];
-        state[index] = state[last_index];
-        health[index] = health[last_index];
-        max_health[index] = max_health[last_index];
-        base_max_health[index] = base_max_health[last_index];
-        turns_since_damage[index] = turns_since_damage[last_index];
-        energy[index] = energy[last_index];
-        max_energy[index] = max_energy[last_index];
-        base_damage[index] = base_damage[last_index];
-        base_sight_radius[index] = base_sight_radius[last_index];
-        base_speed[index] = base_speed[last_index];
-        current_damage[index] = current_damage[last_index];
-        current_sight_radius[index] = current_sight_radius[last_index];
-        current_speed[index] = current_speed[last_index];
-        age[index] = age[last_index];
-        parent_id[index] = parent_id[last_index];
-        base_nutritional_value[index] = base_nutritional_value[last_index];
-        prime_age[index] = prime_age[last_index];
-        penalty_per_year[index] = penalty_per_year[last_index];
-        minimum_nutritional_value[index] = minimum_nutritional_value[last_index];
-    }
-
-    // Pop the back of all vectors
-    is_alive.pop_back();
-    x.pop_back();
-    y.pop_back();
-    prev_x.pop_back();
-    prev_y.pop_back();
-    target_x.pop_back();
-    target_y.pop_back();
-    target_id.pop_back();
-    type.pop_back();
-    state.pop_back();
-    health.pop_back();
-    max_health.pop_back();
-    base_max_health.pop_back();
-    turns_since_damage.pop_back();
-    energy.pop_back();
-    max_energy.pop_back();
-    base_damage.pop_back();
-    base_sight_radius.pop_back();
-    base_speed.pop_back();
-    current_damage.pop_back();
-    current_sight_radius.pop_back();
-    current_speed.pop_back();
-    age.pop_back();
-    parent_id.pop_back();
-    base_nutritional_value.pop_back();
-    prime_age.pop_back();
-    penalty_per_year.pop_back();
-    minimum_nutritional_value.pop_back();
-
-    num_entities--;
-}
-
 // --- Creation Helpers ---
 
 size_t EntityManager::createHerbivore(int start_x, int start_y) {
     size_t id = createEntity();
     type[id] = AnimalType::HERBIVORE;
+    recordBirth(AnimalType::HERBIVORE);
     x[id] = start_x;
     y[id] = start_y;
     // Set previous positions to current positions to prevent animation interpolation from (0,0)
@@ -185,6 +155,7 @@ size_t EntityManager::createHerbivore(int start_x, int start_y) {
 size_t EntityManager::createCarnivore(int start_x, int start_y) {
     size_t id = createEntity();
     type[id] = AnimalType::CARNIVORE;
+    recordBirth(AnimalType::CARNIVORE);
     x[id] = start_x;
     y[id] = start_y;
     // Set previous positions to current positions to prevent animation interpolation from (0,0)
@@ -212,6 +183,7 @@ size_t EntityManager::createCarnivore(int start_x, int start_y) {
 size_t EntityManager::createOmnivore(int start_x, int start_y) {
     size_t id = createEntity();
     type[id] = AnimalType::OMNIVORE;
+    recordBirth(AnimalType::OMNIVORE);
     x[id] = start_x;
     y[id] = start_y;
     // Set previous positions to current positions to prevent animation interpolation from (0,0)
@@ -236,18 +208,111 @@ size_t EntityManager::createOmnivore(int start_x, int start_y) {
     return id;
 }
 
+size_t EntityManager::findEntity(uint64_t entity_uid) const {
+    // uids increase within each species range; entities spawned since the last cleanup follow them
+    for (int t = 0; t < ANIMAL_TYPE_COUNT; ++t) {
+        auto begin = uid.begin() + m_species_begin[t];
+        auto end = uid.begin() + m_species_begin[t + 1];
+        auto found = std::lower_bound(begin, end, entity_uid);
+        if (found != end && *found == entity_uid) return static_cast<size_t>(found - uid.begin());
+    }
+    for (size_t i = m_species_begin[ANIMAL_TYPE_COUNT]; i < num_entities; ++i) {
+        if (uid[i] == entity_uid) return i;
+    }
+    return INVALID_ENTITY_ID;
+}
+
+// Tasks rather than a parallel loop: destroyDeadEntities runs inside an "omp single" of the turn's
+// region, where a nested parallel loop would get a team of one, while the tasks are picked up by
+// the threads waiting at the single's barrier. Outside a parallel region they run in place.
+// Tasks get their own copy of the locals they use, so the loops go through raw pointers.
+template <typename T>
+void EntityManager::gather(std::vector<T>& values, const std::vector<size_t>& order) {
+    std::vector<T> gathered(order.size());
+    T* out = gathered.data();
+    const T* in = values.data();
+    const size_t* from = order.data();
+    #pragma omp taskloop
+    for (size_t i = 0; i < order.size(); ++i) {
+        out[i] = in[from[i]];
+    }
+    values.swap(gathered);
+}
+
+void EntityManager::reorder(const std::vector<size_t>& order) {
+    gather(is_alive, order);
+    gather(uid, order);
+    gather(x, order);
+    gather(y, order);
+    gather(prev_x, order);
+    gather(prev_y, order);
+    gather(target_x, order);
+    gather(target_y, order);
+    gather(target_id, order);
+    gather(type, order);
+    gather(state, order);
+    gather(last_decision_turn, order);
+    gather(health, order);
+    gather(max_health, order);
+    gather(base_max_health, order);
+    gather(turns_since_damage, order);
+    gather(energy, order);
+    gather(max_energy, order);
+    gather(base_damage, order);
+    gather(base_sight_radius, order);
+    gather(base_speed, order);
+    gather(current_damage, order);
+    gather(current_sight_radius, order);
+    gather(current_speed, order);
+    gather(age, order);
+    gather(parent_id, order);
+    gather(base_nutritional_value, order);
+    gather(prime_age, order);
+    gather(penalty_per_year, order);
+    gather(minimum_nutritional_value, order);
+
+    num_entities = order.size();
+}
+
 void EntityManager::destroyDeadEntities() {
-    // --- This loop is INTENTIONALLY SINGLE-THREADED ---
-    // Parallelizing this loop would introduce race conditions because
-    // destroyEntity() modifies the underlying vectors (swap and pop_back),
-    // which is not thread-safe if multiple threads do it concurrently.
-    // Processing cleanup sequentially is safe.
-    // We iterate backwards to safely use swap-and-pop without invalidating indices
-    // of elements we haven't processed yet within this single thread.
-    for (size_t i = num_entities; i-- > 0; ) {
-        if (!is_alive[i]) {
-            // The destroyEntity function handles the swap-and-pop
-            destroyEntity(i);
-        }
+    // Stable counting sort of the survivors by species: every species ends up in one contiguous
+    // range, in the order its members had before (so uids keep increasing within a range)
+    size_t old_count = num_entities;
+    size_t species_count[ANIMAL_TYPE_COUNT] = {0};
+    for (size_t i = 0; i < old_count; ++i) {
+        if (is_alive[i]) species_count[static_cast<int>(type[i])]++;
+    }
+
+    size_t next_slot[ANIMAL_TYPE_COUNT];
+    m_species_begin[0] = 0;
+    for (int t = 0; t < ANIMAL_TYPE_COUNT; ++t) {
+        next_slot[t] = m_species_begin[t];
+        m_species_begin[t + 1] = m_species_begin[t] + species_count[t];
+    }
+
+    std::vector<size_t> order(m_species_begin[ANIMAL_TYPE_COUNT]);
+    bool unchanged = order.size() == old_count;
+    for (size_t i = 0; i < old_count; ++i) {
+        if (!is_alive[i]) continue;
+        size_t slot = next_slot[static_cast<int>(type[i])]++;
+        order[slot] = i;
+        unchanged = unchanged && slot == i;
+    }
+    if (unchanged) return;
+
+    reorder(order);
+
+    // Targets (kept across turns, see AISystem) and parents follow their entities to the new
+    // slots; references to entities that died are cleared
+    std::vector<size_t> new_index(old_count, INVALID_ENTITY_ID);
+    size_t* new_index_of = new_index.data();
+    const size_t* old_index_of = order.data();
+    #pragma omp taskloop
+    for (size_t i = 0; i < num_entities; ++i) new_index_of[old_index_of[i]] = i;
+
+    #pragma omp taskloop
+    for (size_t i = 0; i < num_entities; ++i) {
+        if (target_id[i] < old_count) target_id[i] = new_index_of[target_id[i]];
+        if (parent_id[i] < old_count) parent_id[i] = new_index_of[parent_id[i]];
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,122 @@
+#include "core/FlowField.h"
+#include "core/World.h"
+#include <algorithm>
+
+// Key layout: species in the top byte, then region y and region x (28 bits each)
+uint64_t FlowFieldCache::getKey(AnimalType type, int goal_x, int goal_y) {
+    uint64_t region_x = static_cast<uint32_t>(goal_x / FLOW_REGION_SIZE);
+    uint64_t region_y = static_cast<uint32_t>(goal_y / FLOW_REGION_SIZE);
+    return (static_cast<uint64_t>(type) << 56) | (region_y << 28) | region_x;
+}
+
+bool FlowFieldCache::isInWindow(int goal_x, int goal_y, int x, int y) {
+    int region_left = goal_x / FLOW_REGION_SIZE * FLOW_REGION_SIZE;
+    int region_top = goal_y / FLOW_REGION_SIZE * FLOW_REGION_SIZE;
+    return x >= region_left - FLOW_FIELD_MARGIN && x < region_left + FLOW_REGION_SIZE + FLOW_FIELD_MARGIN &&
+           y >= region_top - FLOW_FIELD_MARGIN && y < region_top + FLOW_REGION_SIZE + FLOW_FIELD_MARGIN;
+}
+
+const FlowField* FlowFieldCache::find(AnimalType type, int goal_x, int goal_y) const {
+    auto it = m_fields.find(getKey(type, goal_x, goal_y));
+    return it != m_fields.end() ? &it->second : nullptr;
+}
+
+void FlowFieldCache::prepare(const uint64_t* keys, size_t key_count, const World& world, int turn) {
+    // 1. Refresh existing fields and collect the missing keys (once each)
+    #pragma omp single
+    {
+        m_missing.clear();
+        for (size_t k = 0; k < key_count; ++k) {
+            auto it = m_fields.find(keys[k]);
+            if (it != m_fields.end()) {
+                it->second.last_used_turn = turn;
+            } else {
+                m_missing.push_back(keys[k]);
+            }
+        }
+        std::sort(m_missing.begin(), m_missing.end());
+        m_missing.erase(std::unique(m_missing.begin(), m_missing.end()), m_missing.end());
+        m_built.resize(m_missing.size());
+    }
+
+    // 2. Build the missing fields across the team; each one is independent
+    #pragma omp for schedule(dynamic)
+    for (size_t i = 0; i < m_missing.size(); ++i) {
+        build(m_missing[i], world, m_built[i]);
+    }
+
+    #pragma omp single
+    {
+        for (size_t i = 0; i < m_missing.size(); ++i) {
+            m_built[i].last_used_turn = turn;
+            m_fields.emplace(m_missing[i], std::move(m_built[i]));
+        }
+        m_built.clear();
+
+        // 3. Evict idle fields
+        for (auto it = m_fields.begin(); it != m_fields.end();) {
+            if (turn - it->second.last_used_turn > FLOW_FIELD_MAX_IDLE_TURNS) {
+                it = m_fields.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+void FlowFieldCache::build(uint64_t key, const World& world, FlowField& out_field) {
+    AnimalType type = static_cast<AnimalType>(key >> 56);
+    int region_y = static_cast<int>((key >> 28) & 0xFFFFFFF);
+    int region_x = static_cast<int>(key & 0xFFFFFFF);
+
+    int region_left = region_x * FLOW_REGION_SIZE;
+    int region_top = region_y * FLOW_REGION_SIZE;
+    int left = std::max(0, region_left - FLOW_FIELD_MARGIN);
+    int top = std::max(0, region_top - FLOW_FIELD_MARGIN);
+    int right = std::min(world.getWidth() - 1, region_left + FLOW_REGION_SIZE - 1 + FLOW_FIELD_MARGIN);
+    int bottom = std::min(world.getHeight() - 1, region_top + FLOW_REGION_SIZE - 1 + FLOW_FIELD_MARGIN);
+
+    out_field.origin_x = left;
+    out_field.origin_y = top;
+    out_field.width = right - left + 1;
+    out_field.height = bottom - top + 1;
+    out_field.region_x = region_x;
+    out_field.region_y = region_y;
+    out_field.distances.assign(static_cast<size_t>(out_field.width) * out_field.height, FLOW_FIELD_UNREACHABLE);
+
+    // Multi-source BFS from every passable tile of the goal region. Moves are 8-connected
+    // and only the destination tile must be passable, like MovementSystem's steps.
+    std::vector<int> frontier; // Local tile indices
+    int region_right = std::min(right, region_left + FLOW_REGION_SIZE - 1);
+    int region_bottom = std::min(bottom, region_top + FLOW_REGION_SIZE - 1);
+    for (int y = region_top; y <= region_bottom; ++y) {
+        for (int x = region_left; x <= region_right; ++x) {
+            if (!world.canMove(x, y, type)) continue;
+            int local = (y - top) * out_field.width + (x - left);
+            out_field.distances[local] = 0;
+            frontier.push_back(local);
+        }
+    }
+
+    for (size_t head = 0; head < frontier.size(); ++head) {
+        int local = frontier[head];
+        int local_x = local % out_field.width;
+        int local_y = local / out_field.width;
+        uint16_t next_distance = out_field.distances[local] + 1;
+
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                int nx = local_x + dx;
+                int ny = local_y + dy;
+                if ((dx == 0 && dy == 0) || nx < 0 || nx >= out_field.width || ny < 0 || ny >= out_field.height) continue;
+
+                int neighbor = ny * out_field.width + nx;
+                if (out_field.distances[neighbor] != FLOW_FIELD_UNREACHABLE) continue;
+                if (!world.canMove(left + nx, top + ny, type)) continue;
+
+                out_field.distances[neighbor] = next_distance;
+                frontier.push_back(neighbor);
+            }
+        }
+    }
+}
@@ -0,0 +1,382 @@
+#include "core/HierarchicalPathfinder.h"
+#include "core/World.h"
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <queue>
+#include <utility>
+
+static int getClustersX(const World& world) {
+    return (world.getWidth() + PATH_CLUSTER_SIZE - 1) / PATH_CLUSTER_SIZE;
+}
+
+static int getClusterIndex(const World& world, int x, int y) {
+    return (y / PATH_CLUSTER_SIZE) * getClustersX(world) + x / PATH_CLUSTER_SIZE;
+}
+
+// Key layout: species in the top byte, then the source and destination region (28 bits each)
+uint64_t HierarchicalPathfinder::getRouteKey(const World& world, AnimalType type, int from_x, int from_y, int to_x, int to_y) const {
+    const AbstractGraph& graph = m_graphs[static_cast<int>(type)];
+    if (!graph.built) return INVALID_ROUTE_KEY;
+
+    int from_region = graph.tile_regions[static_cast<size_t>(from_y) * world.getWidth() + from_x];
+    int to_region = graph.tile_regions[static_cast<size_t>(to_y) * world.getWidth() + to_x];
+    if (from_region < 0 || to_region < 0) return INVALID_ROUTE_KEY;
+    return (static_cast<uint64_t>(type) << 56) | (static_cast<uint64_t>(from_region) << 28) | static_cast<uint64_t>(to_region);
+}
+
+void HierarchicalPathfinder::clear() {
+    for (AbstractGraph& graph : m_graphs) {
+        graph = AbstractGraph();
+    }
+    m_routes.clear();
+}
+
+void HierarchicalPathfinder::prepareGraph(AnimalType type, const World& world) {
+    // built only changes behind the barrier ending buildGraph, so every thread sees the same value
+    AbstractGraph& graph = m_graphs[static_cast<int>(type)];
+    if (!graph.built) buildGraph(type, world, graph);
+}
+
+void HierarchicalPathfinder::prepareRoutes(const uint64_t* keys, size_t key_count) {
+    // 1. Collect the missing routes (once each)
+    #pragma omp single
+    {
+        m_missing.clear();
+        for (size_t k = 0; k < key_count; ++k) {
+            if (keys[k] != INVALID_ROUTE_KEY && m_routes.find(keys[k]) == m_routes.end()) m_missing.push_back(keys[k]);
+        }
+        std::sort(m_missing.begin(), m_missing.end());
+        m_missing.erase(std::unique(m_missing.begin(), m_missing.end()), m_missing.end());
+        m_found.resize(m_missing.size());
+    }
+    if (m_missing.empty()) return; // Same answer on every thread after the single's barrier
+
+    // 2. Route searches are independent; each thread keeps its own Dijkstra state
+    RouteSearch search;
+    #pragma omp for schedule(dynamic)
+    for (size_t i = 0; i < m_missing.size(); ++i) {
+        uint64_t key = m_missing[i];
+        const AbstractGraph& graph = m_graphs[key >> 56];
+        int from_region = static_cast<int>((key >> 28) & 0xFFFFFFF);
+        int to_region = static_cast<int>(key & 0xFFFFFFF);
+        findRoute(graph, from_region, to_region, search, m_found[i]);
+    }
+
+    #pragma omp single
+    {
+        for (size_t i = 0; i < m_missing.size(); ++i) {
+            // The rest of a route from each later region on it is that region's route too, so an
+            // entity reaching a waypoint can steer on without a new search
+            const ClusterRoute& route = m_found[i];
+            uint64_t goal_bits = m_missing[i] & ~(static_cast<uint64_t>(0xFFFFFFF) << 28);
+            for (size_t leg = 1; leg < route.regions.size(); ++leg) {
+                uint64_t key = goal_bits | (static_cast<uint64_t>(route.regions[leg]) << 28);
+                if (m_routes.find(key) != m_routes.end()) continue;
+                ClusterRoute rest;
+                rest.reachable = true;
+                rest.regions.assign(route.regions.begin() + leg, route.regions.end());
+                rest.waypoint_x.assign(route.waypoint_x.begin() + leg, route.waypoint_x.end());
+                rest.waypoint_y.assign(route.waypoint_y.begin() + leg, route.waypoint_y.end());
+                m_routes.emplace(key, std::move(rest));
+            }
+            m_routes.emplace(m_missing[i], std::move(m_found[i]));
+        }
+        m_found.clear();
+    }
+}
+
+bool HierarchicalPathfinder::getWaypoint(const World& world, AnimalType type, int x, int y, int goal_x, int goal_y, int& out_x, int& out_y) const {
+    auto it = m_routes.find(getRouteKey(world, type, x, y, goal_x, goal_y));
+    if (it == m_routes.end() || !it->second.reachable || it->second.regions.empty()) return false;
+
+    // Routes are keyed by the entity's own region, so the first waypoint is the one to take
+    out_x = it->second.waypoint_x[0];
+    out_y = it->second.waypoint_y[0];
+    return true;
+}
+
+// Reached by every thread of the team: the loops over clusters are shared, the entrance scan
+// runs on one thread
+void HierarchicalPathfinder::buildGraph(AnimalType type, const World& world, AbstractGraph& graph) {
+    int clusters_x = getClustersX(world);
+    int clusters_y = (world.getHeight() + PATH_CLUSTER_SIZE - 1) / PATH_CLUSTER_SIZE;
+    #pragma omp single
+    {
+        graph.nodes.clear();
+        graph.cluster_nodes.assign(static_cast<size_t>(clusters_x) * clusters_y, std::vector<int>());
+    }
+    labelRegions(type, world, graph);
+
+    auto getRegion = [&](int x, int y) { return graph.tile_regions[static_cast<size_t>(y) * world.getWidth() + x]; };
+    auto addEntrance = [&](int inside_x, int inside_y, int outside_x, int outside_y) {
+        int inside = static_cast<int>(graph.nodes.size());
+        int outside = inside + 1;
+        graph.nodes.push_back({inside_x, inside_y, getClusterIndex(world, inside_x, inside_y), getRegion(inside_x, inside_y), {{outside, 1}}});
+        graph.nodes.push_back({outside_x, outside_y, getClusterIndex(world, outside_x, outside_y), getRegion(outside_x, outside_y), {{inside, 1}}});
+        graph.cluster_nodes[graph.nodes[inside].cluster].push_back(inside);
+        graph.cluster_nodes[graph.nodes[outside].cluster].push_back(outside);
+        graph.region_nodes[graph.nodes[inside].region].push_back(inside);
+        graph.region_nodes[graph.nodes[outside].region].push_back(outside);
+    };
+
+    // 1. Entrances, per cluster-sized segment of each vertical and horizontal border: one per
+    //    maximal run of straight passable pairs across it, placed at the middle of the run, plus
+    //    the diagonal pairs (moves are 8-connected) that join regions no straight entrance of the
+    //    segment joins
+    #pragma omp single
+    {
+        std::vector<std::pair<int, int>> linked; // Region pairs joined along the current segment
+
+        auto scanSegment = [&](bool vertical, int border, int begin, int end) {
+            int length = vertical ? world.getHeight() : world.getWidth();
+            // Tile at position t along the border, on its near (side 0) or far (side 1) side
+            auto getTile = [&](int t, int side, int& x, int& y) {
+                x = vertical ? border - 1 + side : t;
+                y = vertical ? t : border - 1 + side;
+            };
+            auto isOpen = [&](int near_t, int far_t) {
+                if (far_t < 0 || far_t >= length) return false;
+                int near_x, near_y, far_x, far_y;
+                getTile(near_t, 0, near_x, near_y);
+                getTile(far_t, 1, far_x, far_y);
+                return world.canMove(near_x, near_y, type) && world.canMove(far_x, far_y, type);
+            };
+            auto getRegionPair = [&](int near_t, int far_t) {
+                int near_x, near_y, far_x, far_y;
+                getTile(near_t, 0, near_x, near_y);
+                getTile(far_t, 1, far_x, far_y);
+                return std::make_pair(getRegion(near_x, near_y), getRegion(far_x, far_y));
+            };
+            auto link = [&](int near_t, int far_t) {
+                int near_x, near_y, far_x, far_y;
+                getTile(near_t, 0, near_x, near_y);
+                getTile(far_t, 1, far_x, far_y);
+                linked.push_back(getRegionPair(near_t, far_t));
+                addEntrance(near_x, near_y, far_x, far_y);
+            };
+
+            linked.clear();
+            int run_start = -1;
+            for (int t = begin; t <= end; ++t) {
+                bool open = t < end && isOpen(t, t);
+                if (open && run_start < 0) run_start = t;
+                if (!open && run_start >= 0) {
+                    int middle = (run_start + t - 1) / 2;
+                    link(middle, middle);
+                    run_start = -1;
+                }
+            }
+            for (int t = begin; t < end; ++t) {
+                for (int step = -1; step <= 1; step += 2) {
+                    if (!isOpen(t, t + step)) continue;
+                    if (std::find(linked.begin(), linked.end(), getRegionPair(t, t + step)) != linked.end()) continue;
+                    link(t, t + step);
+                }
+            }
+        };
+
+        for (int border_x = PATH_CLUSTER_SIZE; border_x < world.getWidth(); border_x += PATH_CLUSTER_SIZE) {
+            for (int cluster_top = 0; cluster_top < world.getHeight(); cluster_top += PATH_CLUSTER_SIZE) {
+                scanSegment(true, border_x, cluster_top, std::min(world.getHeight(), cluster_top + PATH_CLUSTER_SIZE));
+            }
+        }
+        for (int border_y = PATH_CLUSTER_SIZE; border_y < world.getHeight(); border_y += PATH_CLUSTER_SIZE) {
+            for (int cluster_left = 0; cluster_left < world.getWidth(); cluster_left += PATH_CLUSTER_SIZE) {
+                scanSegment(false, border_y, cluster_left, std::min(world.getWidth(), cluster_left + PATH_CLUSTER_SIZE));
+            }
+        }
+    }
+
+    // 2. Intra-cluster edges: BFS (8-connected, like movement) from each entrance node, restricted
+    //    to its cluster. Clusters only touch their own nodes' edge lists, so they run in parallel.
+    {
+        std::vector<int> distances(PATH_CLUSTER_SIZE * PATH_CLUSTER_SIZE);
+        std::vector<int> frontier;
+
+        #pragma omp for schedule(dynamic)
+        for (int cluster = 0; cluster < clusters_x * clusters_y; ++cluster) {
+            const std::vector<int>& nodes = graph.cluster_nodes[cluster];
+            int left = (cluster % clusters_x) * PATH_CLUSTER_SIZE;
+            int top = (cluster / clusters_x) * PATH_CLUSTER_SIZE;
+            int cluster_width = std::min(PATH_CLUSTER_SIZE, world.getWidth() - left);
+            int cluster_height = std::min(PATH_CLUSTER_SIZE, world.getHeight() - top);
+
+            for (int node_id : nodes) {
+                AbstractNode& node = graph.nodes[node_id];
+                std::fill(distances.begin(), distances.end(), -1);
+                frontier.clear();
+                int start = (node.y - top) * PATH_CLUSTER_SIZE + (node.x - left);
+                distances[start] = 0;
+                frontier.push_back(start);
+
+                for (size_t head = 0; head < frontier.size(); ++head) {
+                    int local_x = frontier[head] % PATH_CLUSTER_SIZE;
+                    int local_y = frontier[head] / PATH_CLUSTER_SIZE;
+                    for (int dy = -1; dy <= 1; ++dy) {
+                        for (int dx = -1; dx <= 1; ++dx) {
+                            int nx = local_x + dx;
+                            int ny = local_y + dy;
+                            if (nx < 0 || nx >= cluster_width || ny < 0 || ny >= cluster_height) continue;
+                            int neighbor = ny * PATH_CLUSTER_SIZE + nx;
+                            if (distances[neighbor] >= 0 || !world.canMove(left + nx, top + ny, type)) continue;
+                            distances[neighbor] = distances[frontier[head]] + 1;
+                            frontier.push_back(neighbor);
+                        }
+                    }
+                }
+
+                for (int other_id : nodes) {
+                    if (other_id == node_id) continue;
+                    const AbstractNode& other = graph.nodes[other_id];
+                    int distance = distances[(other.y - top) * PATH_CLUSTER_SIZE + (other.x - left)];
+                    if (distance >= 0) node.edges.push_back({other_id, distance});
+                }
+            }
+        }
+    }
+    #pragma omp single
+    graph.built = true;
+}
+
+void HierarchicalPathfinder::labelRegions(AnimalType type, const World& world, AbstractGraph& graph) {
+    int clusters_x = getClustersX(world);
+    int cluster_count = static_cast<int>(graph.cluster_nodes.size());
+    int width = world.getWidth();
+    #pragma omp single
+    {
+        graph.tile_regions.assign(static_cast<size_t>(width) * world.getHeight(), -1);
+        graph.cluster_first_region.assign(cluster_count, 0);
+    }
+
+    // 1. Flood fill (8-connected, like movement) inside each cluster with cluster-local labels.
+    //    Clusters only touch their own tiles, so they run in parallel.
+    {
+        std::vector<int> frontier;
+
+        #pragma omp for schedule(dynamic)
+        for (int cluster = 0; cluster < cluster_count; ++cluster) {
+            int left = (cluster % clusters_x) * PATH_CLUSTER_SIZE;
+            int top = (cluster / clusters_x) * PATH_CLUSTER_SIZE;
+            int right = std::min(left + PATH_CLUSTER_SIZE, width);
+            int bottom = std::min(top + PATH_CLUSTER_SIZE, world.getHeight());
+
+            for (int y = top; y < bottom; ++y) {
+                for (int x = left; x < right; ++x) {
+                    size_t start = static_cast<size_t>(y) * width + x;
+                    if (graph.tile_regions[start] >= 0 || !world.canMove(x, y, type)) continue;
+
+                    int label = graph.cluster_first_region[cluster]++;
+                    graph.tile_regions[start] = label;
+                    frontier.assign(1, static_cast<int>(start));
+                    for (size_t head = 0; head < frontier.size(); ++head) {
+                        int tile_x = frontier[head] % width;
+                        int tile_y = frontier[head] / width;
+                        for (int dy = -1; dy <= 1; ++dy) {
+                            for (int dx = -1; dx <= 1; ++dx) {
+                                int nx = tile_x + dx;
+                                int ny = tile_y + dy;
+                                if (nx < left || nx >= right || ny < top || ny >= bottom) continue;
+                                size_t neighbor = static_cast<size_t>(ny) * width + nx;
+                                if (graph.tile_regions[neighbor] >= 0 || !world.canMove(nx, ny, type)) continue;
+                                graph.tile_regions[neighbor] = label;
+                                frontier.push_back(static_cast<int>(neighbor));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // 2. Global region ids: each cluster's labels follow those of the clusters before it
+    #pragma omp single
+    {
+        int region_count = 0;
+        for (int cluster = 0; cluster < cluster_count; ++cluster) {
+            int cluster_regions = graph.cluster_first_region[cluster];
+            graph.cluster_first_region[cluster] = region_count;
+            region_count += cluster_regions;
+        }
+        graph.region_nodes.assign(region_count, std::vector<int>());
+    }
+
+    #pragma omp for schedule(static)
+    for (int y = 0; y < world.getHeight(); ++y) {
+        for (int x = 0; x < width; ++x) {
+            int& region = graph.tile_regions[static_cast<size_t>(y) * width + x];
+            if (region >= 0) region += graph.cluster_first_region[getClusterIndex(world, x, y)];
+        }
+    }
+}
+
+void HierarchicalPathfinder::findRoute(const AbstractGraph& graph, int from_region, int to_region, RouteSearch& search, ClusterRoute& out_route) {
+    out_route = ClusterRoute();
+    if (from_region == to_region) {
+        out_route.reachable = true; // Nothing to route; the goal is in the same region
+        return;
+    }
+
+    if (search.distances.size() != graph.nodes.size()) {
+        search.distances.assign(graph.nodes.size(), INT_MAX);
+        search.previous.assign(graph.nodes.size(), -1);
+    }
+
+    // Dijkstra from every entrance node of the source region (all reachable from the entity's
+    // tile), stopping at the first node settled in the destination region
+    typedef std::pair<int, int> QueueEntry; // (distance, node)
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    for (int node_id : graph.region_nodes[from_region]) {
+        search.distances[node_id] = 0;
+        search.touched.push_back(node_id);
+        queue.push({0, node_id});
+    }
+
+    int reached = -1;
+    while (!queue.empty()) {
+        QueueEntry entry = queue.top();
+        queue.pop();
+        if (entry.first > search.distances[entry.second]) continue; // Stale entry
+
+        const AbstractNode& node = graph.nodes[entry.second];
+        if (node.region == to_region) {
+            reached = entry.second;
+            break;
+        }
+        for (const AbstractEdge& edge : node.edges) {
+            int distance = entry.first + edge.cost;
+            if (distance < search.distances[edge.to]) {
+                if (search.distances[edge.to] == INT_MAX) search.touched.push_back(edge.to);
+                search.distances[edge.to] = distance;
+                search.previous[edge.to] = entry.second;
+                queue.push({distance, edge.to});
+            }
+        }
+    }
+
+    if (reached >= 0) {
+        // Walk back to the source; every node whose predecessor lies in another region is the
+        // entry tile of the next region on the route, i.e. the waypoint for that predecessor's region
+        std::vector<int> nodes;
+        for (int node_id = reached; node_id >= 0; node_id = search.previous[node_id]) {
+            nodes.push_back(node_id);
+        }
+        std::reverse(nodes.begin(), nodes.end());
+
+        for (size_t i = 1; i < nodes.size(); ++i) {
+            const AbstractNode& from = graph.nodes[nodes[i - 1]];
+            const AbstractNode& to = graph.nodes[nodes[i]];
+            if (from.region == to.region) continue;
+            out_route.regions.push_back(from.region);
+            out_route.waypoint_x.push_back(to.x);
+            out_route.waypoint_y.push_back(to.y);
+        }
+        out_route.reachable = true;
+    }
+
+    for (int node_id : search.touched) {
+        search.distances[node_id] = INT_MAX;
+        search.previous[node_id] = -1;
+    }
+    search.touched.clear();
+}
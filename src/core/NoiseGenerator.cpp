@@ -0,0 +1,153 @@
+#include "core/NoiseGenerator.h"
+#include "core/Random.h"
+#include <algorithm>
+
+// --- Noise Field Parameters ---
+const int NOISE_OCTAVES = 4;
+const float NOISE_PERSISTENCE = 0.5f;         // Amplitude multiplier per octave
+const float ELEVATION_BASE_FREQUENCY = 1.0f / 48.0f; // Largest elevation features span ~48 tiles
+const float MOISTURE_BASE_FREQUENCY = 1.0f / 32.0f;
+
+// Random streams for the two fields (octave is folded into the stream id)
+const uint64_t NOISE_STREAM_ELEVATION = 0x100;
+const uint64_t NOISE_STREAM_MOISTURE = 0x200;
+
+// --- Biome Threshold Tables ---
+// Elevation bands take priority: low ground is water, high ground is rocky
+const float WATER_MAX_ELEVATION = 0.38f;
+const float ROCKY_MIN_ELEVATION = 0.64f;
+
+// Between the two, biomes are picked by moisture (first band whose max exceeds the value)
+struct MoistureBand {
+    float max_moisture;
+    BiomeId biome;
+};
+
+const MoistureBand MOISTURE_BANDS[] = {
+    {0.40f, BIOME_ID_BARREN},
+    {0.52f, BIOME_ID_GRASSLAND},
+    {0.62f, BIOME_ID_FOREST},
+    {1.01f, BIOME_ID_FERTILE}
+};
+
+// Replacement for a tile whose neighbors violate the adjacency rules.
+// Every entry must be compatible with all biomes (Grassland and Forest are).
+const BiomeId TRANSITION_BIOME[BIOME_ID_COUNT] = {
+    BIOME_ID_FOREST,    // Water: river banks
+    BIOME_ID_GRASSLAND, // Barren
+    BIOME_ID_GRASSLAND, // Rocky: foothills
+    BIOME_ID_GRASSLAND, // Grassland (never conflicts)
+    BIOME_ID_FOREST,    // Forest (never conflicts)
+    BIOME_ID_FOREST     // Fertile
+};
+
+NoiseGenerator::NoiseGenerator(int width, int height, uint64_t seed, const BiomeMask* compatibility)
+    : m_width(width), m_height(height), m_seed(seed) {
+    std::copy(compatibility, compatibility + BIOME_ID_COUNT, m_compatibility);
+}
+
+float NoiseGenerator::latticeValue(uint64_t stream, int octave, int lattice_x, int lattice_y) const {
+    uint64_t counter = (static_cast<uint64_t>(static_cast<uint32_t>(lattice_y)) << 32) | static_cast<uint32_t>(lattice_x);
+    return counterRandomFloat(m_seed, stream + octave, counter);
+}
+
+void NoiseGenerator::sampleRow(int y, uint64_t stream, float base_frequency, std::vector<float>& lattice, float* out_row) const {
+    std::fill(out_row, out_row + m_width, 0.0f);
+
+    float frequency = base_frequency;
+    float amplitude = 1.0f;
+    float total_amplitude = 0.0f;
+
+    for (int octave = 0; octave < NOISE_OCTAVES; ++octave) {
+        // Interpolate the two lattice rows around y once, so the per-tile loop is 1D
+        float fy = y * frequency;
+        int lattice_y = static_cast<int>(fy);
+        float ty = fy - lattice_y;
+        ty = ty * ty * (3.0f - 2.0f * ty); // Smoothstep
+
+        int lattice_count = static_cast<int>((m_width - 1) * frequency) + 2;
+        lattice.resize(lattice_count);
+        for (int i = 0; i < lattice_count; ++i) {
+            float top = latticeValue(stream, octave, i, lattice_y);
+            float bottom = latticeValue(stream, octave, i, lattice_y + 1);
+            lattice[i] = top + (bottom - top) * ty;
+        }
+
+        const float* lattice_data = lattice.data();
+        #pragma omp simd
+        for (int x = 0; x < m_width; ++x) {
+            float fx = x * frequency;
+            int lattice_x = static_cast<int>(fx);
+            float tx = fx - lattice_x;
+            tx = tx * tx * (3.0f - 2.0f * tx);
+            float left = lattice_data[lattice_x];
+            float right = lattice_data[lattice_x + 1];
+            out_row[x] += amplitude * (left + (right - left) * tx);
+        }
+
+        total_amplitude += amplitude;
+        frequency *= 2.0f;
+        amplitude *= NOISE_PERSISTENCE;
+    }
+
+    float normalize = 1.0f / total_amplitude;
+    #pragma omp simd
+    for (int x = 0; x < m_width; ++x) {
+        out_row[x] *= normalize;
+    }
+}
+
+BiomeId NoiseGenerator::classify(float elevation, float moisture) {
+    if (elevation < WATER_MAX_ELEVATION) return BIOME_ID_WATER;
+    if (elevation >= ROCKY_MIN_ELEVATION) return BIOME_ID_ROCKY;
+
+    for (const MoistureBand& band : MOISTURE_BANDS) {
+        if (moisture < band.max_moisture) return band.biome;
+    }
+    return BIOME_ID_FERTILE;
+}
+
+void NoiseGenerator::generate(std::vector<uint8_t>& out_biomes) const {
+    size_t tile_count = static_cast<size_t>(m_width) * m_height;
+    std::vector<uint8_t> raw_biomes(tile_count);
+
+    // Pass 1: sample both fields and classify, one row per iteration
+    #pragma omp parallel
+    {
+        std::vector<float> lattice;
+        std::vector<float> elevation(m_width);
+        std::vector<float> moisture(m_width);
+
+        #pragma omp for schedule(static)
+        for (int y = 0; y < m_height; ++y) {
+            sampleRow(y, NOISE_STREAM_ELEVATION, ELEVATION_BASE_FREQUENCY, lattice, elevation.data());
+            sampleRow(y, NOISE_STREAM_MOISTURE, MOISTURE_BASE_FREQUENCY, lattice, moisture.data());
+
+            uint8_t* row = &raw_biomes[static_cast<size_t>(y) * m_width];
+            for (int x = 0; x < m_width; ++x) {
+                row[x] = classify(elevation[x], moisture[x]);
+            }
+        }
+    }
+
+    // Pass 2: enforce the adjacency rules. Both sides of a conflicting pair are replaced
+    // by a universally compatible transition biome; since the rules are symmetric, the
+    // result has no conflicts and no tile depends on another tile's replacement.
+    out_biomes.resize(tile_count);
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < m_height; ++y) {
+        for (int x = 0; x < m_width; ++x) {
+            size_t index = static_cast<size_t>(y) * m_width + x;
+            uint8_t biome = raw_biomes[index];
+            BiomeMask allowed = m_compatibility[biome];
+
+            BiomeMask neighbors = 0;
+            if (x > 0) neighbors |= biomeBit(static_cast<BiomeId>(raw_biomes[index - 1]));
+            if (x < m_width - 1) neighbors |= biomeBit(static_cast<BiomeId>(raw_biomes[index + 1]));
+            if (y > 0) neighbors |= biomeBit(static_cast<BiomeId>(raw_biomes[index - m_width]));
+            if (y < m_height - 1) neighbors |= biomeBit(static_cast<BiomeId>(raw_biomes[index + m_width]));
+
+            out_biomes[index] = (neighbors & ~allowed) ? static_cast<uint8_t>(TRANSITION_BIOME[biome]) : biome;
+        }
+    }
+}
@@ -1,234 +1,241 @@
 #include "core/WFCGenerator.h"
 #include "resources/Biome.h"
 #include <algorithm>
-#include <limits>
 
-WFCGenerator::WFCGenerator(int width, int height, std::mt19937& rng) 
+WFCGenerator::WFCGenerator(int width, int height, std::mt19937& rng)
     : m_width(width), m_height(height), m_rng(rng) {
-    m_grid.resize(height, std::vector<WFCCell>(width));
+    m_domains.assign(static_cast<size_t>(width) * height, ALL_BIOMES_MASK);
+    m_collapsed.assign(static_cast<size_t>(width) * height, NOT_COLLAPSED);
     setupAdjacencyRules();
 }
 
 void WFCGenerator::setupAdjacencyRules() {
     // Define which biomes can be adjacent to each other
     // More permissive rules to avoid WFC getting stuck and create natural transitions
-    
+
     // Water can be next to: Water, Barren, Grassland, Forest (rivers through forests)
     m_adjacency_rules[&BIOME_WATER] = {&BIOME_WATER, &BIOME_BARREN, &BIOME_GRASSLAND, &BIOME_FOREST};
-    
+
     // Barren can be next to: Water, Barren, Rocky, Grassland, Forest (transition zones)
     m_adjacency_rules[&BIOME_BARREN] = {&BIOME_WATER, &BIOME_BARREN, &BIOME_ROCKY, &BIOME_GRASSLAND, &BIOME_FOREST};
-    
+
     // Rocky can be next to: Barren, Rocky, Grassland, Forest (mountains near various biomes)
     m_adjacency_rules[&BIOME_ROCKY] = {&BIOME_BARREN, &BIOME_ROCKY, &BIOME_GRASSLAND, &BIOME_FOREST};
-    
+
     // Grassland can be next to: Water, Barren, Rocky, Grassland, Forest, Fertile (central transition biome)
     m_adjacency_rules[&BIOME_GRASSLAND] = {&BIOME_WATER, &BIOME_BARREN, &BIOME_ROCKY, &BIOME_GRASSLAND, &BIOME_FOREST, &BIOME_FERTILE};
-    
+
     // Forest can be next to: Water, Barren, Rocky, Grassland, Forest, Fertile (forests are versatile)
     m_adjacency_rules[&BIOME_FOREST] = {&BIOME_WATER, &BIOME_BARREN, &BIOME_ROCKY, &BIOME_GRASSLAND, &BIOME_FOREST, &BIOME_FERTILE};
-    
+
     // Fertile can be next to: Grassland, Forest, Fertile (rich areas, but can connect to most green areas)
     m_adjacency_rules[&BIOME_FERTILE] = {&BIOME_GRASSLAND, &BIOME_FOREST, &BIOME_FERTILE};
+
+    // Flatten the rules into bitmasks so propagation is a table lookup and an AND.
+    // Biomes without rules allow any neighbor.
+    for (int id = 0; id < BIOME_ID_COUNT; ++id) {
+        auto it = m_adjacency_rules.find(ALL_BIOMES[id]);
+        if (it == m_adjacency_rules.end()) {
+            m_compatibility[id] = ALL_BIOMES_MASK;
+            continue;
+        }
+
+        BiomeMask mask = 0;
+        for (const BiomeType* neighbor : it->second) {
+            mask |= biomeBit(neighbor->id);
+        }
+        m_compatibility[id] = mask;
+    }
+
+    // A neighbor of a cell may keep any biome that is compatible with at least one
+    // biome still possible in that cell
+    for (int mask = 0; mask < 256; ++mask) {
+        BiomeMask support = 0;
+        for (int id = 0; id < BIOME_ID_COUNT; ++id) {
+            if (mask & (1 << id)) {
+                support |= m_compatibility[id];
+            }
+        }
+        m_support[mask] = support;
+    }
 }
 
 void WFCGenerator::initializeGrid() {
-    // Initialize all cells with all possible biomes
-    std::set<const BiomeType*> all_biomes = {
-        &BIOME_WATER, &BIOME_BARREN, &BIOME_ROCKY, 
-        &BIOME_GRASSLAND, &BIOME_FOREST, &BIOME_FERTILE
-    };
-    
-    for (int y = 0; y < m_height; ++y) {
-        for (int x = 0; x < m_width; ++x) {
-            if (!m_grid[y][x].is_collapsed) {
-                m_grid[y][x].possible_biomes = all_biomes;
-            }
+    m_entropy_buckets.assign(BIOME_ID_COUNT + 1, std::vector<int>());
+
+    // Make the grid consistent with any seeded cells before choosing the first cell
+    std::vector<int> to_process;
+    for (int i = 0; i < static_cast<int>(m_collapsed.size()); ++i) {
+        if (m_collapsed[i] != NOT_COLLAPSED) {
+            to_process.push_back(i);
+        }
+    }
+    propagateConstraints(to_process);
+
+    // Start the queue from scratch; propagation above may have queued duplicates
+    for (auto& bucket : m_entropy_buckets) {
+        bucket.clear();
+    }
+    for (int i = 0; i < static_cast<int>(m_domains.size()); ++i) {
+        if (m_collapsed[i] == NOT_COLLAPSED) {
+            m_entropy_buckets[countBiomes(m_domains[i])].push_back(i);
         }
     }
 }
 
 bool WFCGenerator::generate() {
     initializeGrid();
-    
+
+    // A seeded cell with no compatible neighbor leaves an empty domain behind
+    if (!m_entropy_buckets[0].empty()) {
+        return false;
+    }
+
+    std::vector<int> to_process;
+
     // WFC main loop
     while (true) {
-        int min_x, min_y;
-        if (!findLowestEntropyCell(min_x, min_y)) {
+        int index;
+        if (!findLowestEntropyCell(index)) {
             // All cells are collapsed - generation complete!
             return true;
         }
-        
-        if (!collapseCell(min_x, min_y)) {
+
+        if (!collapseCell(index)) {
             // Contradiction occurred - generation failed
             return false;
         }
-        
-        if (!propagateConstraints(min_x, min_y)) {
+
+        to_process.clear();
+        to_process.push_back(index);
+        if (!propagateConstraints(to_process)) {
             // Propagation failed - contradiction
             return false;
         }
     }
 }
 
-bool WFCGenerator::findLowestEntropyCell(int& out_x, int& out_y) {
-    int min_entropy = std::numeric_limits<int>::max();
-    std::vector<std::pair<int, int>> candidates;
-    
-    for (int y = 0; y < m_height; ++y) {
-        for (int x = 0; x < m_width; ++x) {
-            if (!m_grid[y][x].is_collapsed) {
-                int entropy = m_grid[y][x].possible_biomes.size();
-                
-                if (entropy == 0) {
-                    // Contradiction - no possible biomes
-                    return false;
-                }
-                
-                if (entropy < min_entropy) {
-                    min_entropy = entropy;
-                    candidates.clear();
-                    candidates.push_back({x, y});
-                } else if (entropy == min_entropy) {
-                    candidates.push_back({x, y});
-                }
+bool WFCGenerator::findLowestEntropyCell(int& out_index) {
+    for (int entropy = 1; entropy <= BIOME_ID_COUNT; ++entropy) {
+        std::vector<int>& bucket = m_entropy_buckets[entropy];
+
+        while (!bucket.empty()) {
+            // Randomly select from candidates with lowest entropy
+            std::uniform_int_distribution<size_t> dist(0, bucket.size() - 1);
+            size_t pick = dist(m_rng);
+            int index = bucket[pick];
+            bucket[pick] = bucket.back();
+            bucket.pop_back();
+
+            // Skip stale entries left behind when the cell moved to another bucket
+            if (m_collapsed[index] == NOT_COLLAPSED && countBiomes(m_domains[index]) == entropy) {
+                out_index = index;
+                return true;
             }
         }
     }
-    
-    if (candidates.empty()) {
-        // All cells are collapsed
-        return false;
-    }
-    
-    // Randomly select from candidates with lowest entropy
-    std::uniform_int_distribution<int> dist(0, candidates.size() - 1);
-    auto selected = candidates[dist(m_rng)];
-    out_x = selected.first;
-    out_y = selected.second;
-    
-    return true;
+
+    // All cells are collapsed
+    return false;
 }
 
-bool WFCGenerator::collapseCell(int x, int y) {
-    WFCCell& cell = m_grid[y][x];
-    
-    if (cell.is_collapsed || cell.possible_biomes.empty()) {
+bool WFCGenerator::collapseCell(int index) {
+    BiomeMask domain = m_domains[index];
+    int options = countBiomes(domain);
+
+    if (m_collapsed[index] != NOT_COLLAPSED || options == 0) {
         return false;
     }
-    
+
     // Randomly select a biome from possible options
-    std::vector<const BiomeType*> options(cell.possible_biomes.begin(), cell.possible_biomes.end());
-    std::uniform_int_distribution<int> dist(0, options.size() - 1);
-    
-    cell.collapsed_biome = options[dist(m_rng)];
-    cell.is_collapsed = true;
-    cell.possible_biomes.clear();
-    
+    std::uniform_int_distribution<int> dist(0, options - 1);
+    int choice = dist(m_rng);
+
+    for (int id = 0; id < BIOME_ID_COUNT; ++id) {
+        if (!(domain & (1 << id))) continue;
+        if (choice-- == 0) {
+            m_collapsed[index] = static_cast<uint8_t>(id);
+            m_domains[index] = biomeBit(static_cast<BiomeId>(id));
+            break;
+        }
+    }
+
     return true;
 }
 
-bool WFCGenerator::propagateConstraints(int start_x, int start_y) {
-    // Use a queue to propagate constraints
-    std::vector<std::pair<int, int>> to_process;
-    to_process.push_back({start_x, start_y});
-    
+bool WFCGenerator::propagateConstraints(std::vector<int>& to_process) {
+    // 4-directional neighbors (up, down, left, right)
+    static const int offsets[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
     while (!to_process.empty()) {
-        auto [x, y] = to_process.back();
+        int index = to_process.back();
         to_process.pop_back();
-        
-        auto neighbors = getNeighbors(x, y);
-        for (auto [nx, ny] : neighbors) {
-            if (m_grid[ny][nx].is_collapsed) {
+
+        int x = index % m_width;
+        int y = index / m_width;
+        BiomeMask allowed = m_support[m_domains[index]];
+
+        for (const auto& offset : offsets) {
+            int nx = x + offset[0];
+            int ny = y + offset[1];
+            if (!isValidCoordinate(nx, ny)) continue;
+
+            int neighbor = ny * m_width + nx;
+            if (m_collapsed[neighbor] != NOT_COLLAPSED) {
                 continue; // Already collapsed, skip
             }
-            
-            // Update neighbor's constraints based on collapsed cell
-            size_t old_size = m_grid[ny][nx].possible_biomes.size();
-            updateNeighborConstraints(x, y, nx, ny);
-            
-            if (m_grid[ny][nx].possible_biomes.empty()) {
+
+            BiomeMask old_domain = m_domains[neighbor];
+            BiomeMask new_domain = old_domain & allowed;
+            if (new_domain == old_domain) continue;
+
+            if (new_domain == 0) {
                 // Contradiction
+                m_domains[neighbor] = 0;
                 return false;
             }
-            
-            // If constraints changed, add to processing queue
-            if (m_grid[ny][nx].possible_biomes.size() != old_size) {
-                to_process.push_back({nx, ny});
-            }
-        }
-    }
-    
-    return true;
-}
 
-void WFCGenerator::updateNeighborConstraints(int x, int y, int nx, int ny) {
-    const BiomeType* collapsed_biome = m_grid[y][x].collapsed_biome;
-    if (!collapsed_biome) return;
-    
-    WFCCell& neighbor = m_grid[ny][nx];
-    
-    // Remove biomes from neighbor that are not compatible with collapsed_biome
-    auto it = neighbor.possible_biomes.begin();
-    while (it != neighbor.possible_biomes.end()) {
-        if (!isValidNeighbor(collapsed_biome, *it)) {
-            it = neighbor.possible_biomes.erase(it);
-        } else {
-            ++it;
+            // Constraints changed: requeue under the new entropy and propagate further
+            m_domains[neighbor] = new_domain;
+            m_entropy_buckets[countBiomes(new_domain)].push_back(neighbor);
+            to_process.push_back(neighbor);
         }
     }
-}
 
-bool WFCGenerator::isValidNeighbor(const BiomeType* current, const BiomeType* neighbor) {
-    auto it = m_adjacency_rules.find(current);
-    if (it == m_adjacency_rules.end()) {
-        return true; // No rules defined, allow any neighbor
-    }
-    
-    return it->second.count(neighbor) > 0;
+    return true;
 }
 
 bool WFCGenerator::isValidCoordinate(int x, int y) const {
     return x >= 0 && x < m_width && y >= 0 && y < m_height;
 }
 
-std::vector<std::pair<int, int>> WFCGenerator::getNeighbors(int x, int y) const {
-    std::vector<std::pair<int, int>> neighbors;
-    
-    // 4-directional neighbors (up, down, left, right)
-    std::vector<std::pair<int, int>> offsets = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
-    
-    for (auto [dx, dy] : offsets) {
-        int nx = x + dx;
-        int ny = y + dy;
-        
-        if (isValidCoordinate(nx, ny)) {
-            neighbors.push_back({nx, ny});
-        }
-    }
-    
-    return neighbors;
+int WFCGenerator::countBiomes(BiomeMask mask) {
+    return __builtin_popcount(mask);
 }
 
 const BiomeType* WFCGenerator::getBiome(int x, int y) const {
     if (!isValidCoordinate(x, y)) {
         return nullptr;
     }
-    
-    return m_grid[y][x].collapsed_biome;
+
+    uint8_t id = m_collapsed[y * m_width + x];
+    return id == NOT_COLLAPSED ? nullptr : ALL_BIOMES[id];
 }
 
 void WFCGenerator::setSeed(int x, int y, const BiomeType* biome) {
-    if (!isValidCoordinate(x, y)) {
+    if (!isValidCoordinate(x, y) || !biome) {
         return;
     }
-    
-    WFCCell& cell = m_grid[y][x];
-    cell.collapsed_biome = biome;
-    cell.is_collapsed = true;
-    cell.possible_biomes.clear();
+
+    int index = y * m_width + x;
+    m_collapsed[index] = biome->id;
+    m_domains[index] = biomeBit(biome->id);
 }
 
 const std::map<const BiomeType*, std::set<const BiomeType*>>& WFCGenerator::getAdjacencyRules() const {
     return m_adjacency_rules;
 }
+
+BiomeMask WFCGenerator::getCompatibilityMask(BiomeId id) const {
+    return m_compatibility[id];
+}
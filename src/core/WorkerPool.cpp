@@ -0,0 +1,53 @@
+#include "core/WorkerPool.h"
+#include <algorithm>
+
+// The first block of every arena; later blocks at least double the previous one
+const size_t SCRATCH_MIN_BLOCK_BYTES = 64 * 1024;
+
+void* ScratchArena::allocateBytes(size_t bytes, size_t alignment) {
+    while (true) {
+        if (m_block < m_blocks.size()) {
+            size_t start = (m_offset + alignment - 1) & ~(alignment - 1);
+            if (start + bytes <= m_block_sizes[m_block]) {
+                m_offset = start + bytes;
+                return m_blocks[m_block].get() + start;
+            }
+            // Later blocks may be left over from a larger turn before a rewind
+            if (m_block + 1 < m_blocks.size()) {
+                ++m_block;
+                m_offset = 0;
+                continue;
+            }
+        }
+
+        size_t block_size = std::max(SCRATCH_MIN_BLOCK_BYTES, bytes + alignment);
+        if (!m_block_sizes.empty()) block_size = std::max(block_size, m_block_sizes.back() * 2);
+        m_blocks.emplace_back(new unsigned char[block_size]);
+        m_block_sizes.push_back(block_size);
+        m_block = m_blocks.size() - 1;
+        m_offset = 0;
+    }
+}
+
+void ScratchArena::reset() {
+    // Nothing is live now, so several blocks can be replaced by one that holds them all
+    if (m_blocks.size() > 1) {
+        size_t total_size = 0;
+        for (size_t size : m_block_sizes) total_size += size;
+        m_blocks.clear();
+        m_block_sizes.clear();
+        m_blocks.emplace_back(new unsigned char[total_size]);
+        m_block_sizes.push_back(total_size);
+    }
+    m_block = 0;
+    m_offset = 0;
+}
+
+void WorkerPool::beginTurn() {
+    size_t thread_count = static_cast<size_t>(omp_get_max_threads());
+    if (m_thread_arenas.size() < thread_count) {
+        m_thread_arenas.resize(thread_count);
+    }
+    for (ScratchArena& arena : m_thread_arenas) arena.reset();
+    m_shared_arena.reset();
+}
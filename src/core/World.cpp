@@ -6,6 +6,7 @@
 #include "systems/SimulationSystems.h"
 #include "common/AnimalConfig.h"
 #include "core/Random.h"
+#include "core/NoiseGenerator.h"
 #include "graphics/GraphicsRenderer.h"
 
 #include <iostream>
@@ -16,10 +17,16 @@
 #include <cmath>
 
 World::World(int w, int h, int cell_size)
-    : width(w), height(h), turn_count(0),
-      m_entityManager(), // Default construct the entity manager
-      grid(height, std::vector<Tile>(width))
+    : width(w), height(h), turn_count(0), m_generation_seed(0),
+      m_generator_type(WorldGeneratorType::REGION_WFC), m_has_fixed_seed(false), m_ai_decision_budget(0),
+      m_entityManager() // Default construct the entity manager
 {
+    m_tiles.resize(static_cast<size_t>(width) * height);
+
+    for (int id = 0; id < RESOURCE_ID_COUNT; ++id) {
+        m_resource_nutrition[id] = ALL_RESOURCES[id] ? ALL_RESOURCES[id]->nutritional_value : 0.0f;
+    }
+
     // Calculate optimal cell size if not provided
     if (cell_size <= 0) {
         spatial_grid_cell_size = calculateOptimalCellSize();
@@ -31,6 +38,21 @@ World::World(int w, int h, int cell_size)
     spatial_grid_width = (width + spatial_grid_cell_size - 1) / spatial_grid_cell_size;
     spatial_grid_height = (height + spatial_grid_cell_size - 1) / spatial_grid_cell_size;
     spatial_grid.resize(spatial_grid_height, std::vector<SpatialGridCell>(spatial_grid_width));
+    spatial_grid_population.assign(spatial_grid_width * spatial_grid_height * ANIMAL_TYPE_COUNT, 0);
+    m_cell_change_turns.assign(spatial_grid_width * spatial_grid_height, -1);
+
+    influence_grid_width = (width + INFLUENCE_CELL_SIZE - 1) / INFLUENCE_CELL_SIZE;
+    influence_grid_height = (height + INFLUENCE_CELL_SIZE - 1) / INFLUENCE_CELL_SIZE;
+    size_t influence_size = static_cast<size_t>(influence_grid_width) * influence_grid_height * ANIMAL_TYPE_COUNT;
+    m_influence_counts.assign(influence_size, 0);
+    m_influence_row_sums.assign(influence_size, 0);
+    m_influence_field.assign(influence_size, 0);
+
+    for (int field = 0; field < SCENT_FIELD_COUNT; ++field) {
+        m_scent[field].assign(static_cast<size_t>(width) * height, 0.0f);
+        m_scent_deposits[field].assign(static_cast<size_t>(width) * height, 0);
+    }
+    m_scent_next.assign(static_cast<size_t>(width) * height, 0.0f);
     
     std::cout << "Spatial grid initialized: " << spatial_grid_width << "x" << spatial_grid_height 
               << " cells (cell size: " << spatial_grid_cell_size << ")" << std::endl;
@@ -38,10 +60,35 @@ World::World(int w, int h, int cell_size)
 
 void World::init(int initial_herbivores, int initial_carnivores, int initial_omnivores) {
     m_entityManager.clear(); // Ensure the entity manager is empty
+    std::fill(m_cell_change_turns.begin(), m_cell_change_turns.end(), -1);
+    for (int field = 0; field < SCENT_FIELD_COUNT; ++field) {
+        std::fill(m_scent[field].begin(), m_scent[field].end(), 0.0f);
+    }
+    m_flow_fields.clear(); // Fields and routes depend on terrain, which is regenerated below
+    m_pathfinder.clear();
+    m_ai_thread_stats.reset();
+    m_metabolism_thread_stats.reset();
 
     // --- NEW: Biome-based Terrain Generation ---
-    generateBiomes();
-    seedResources();
+    // One draw from the global generator seeds every generation stream
+    if (!m_has_fixed_seed) {
+        m_generation_seed = (static_cast<uint64_t>(rng()) << 32) | rng();
+    }
+
+    if (!loadCachedWorld()) {
+        if (m_generator_type == WorldGeneratorType::NOISE_FIELD) {
+            generateNoiseBiomes();
+        } else {
+            generateBiomes();
+        }
+        seedResources();
+        saveCachedWorld();
+    }
+    rebuildTerrainCaches();
+    rebuildRegrowingTiles();
+    // Written for the thread team of update(), so it gets a team of its own here
+    #pragma omp parallel
+    rebuildFoodPyramid();
     // --- END NEW ---
 
     // --- Initialize Animals using EntityManager ---
@@ -57,10 +104,35 @@ void World::init(int initial_herbivores, int initial_carnivores, int initial_omn
     for (int i = 0; i < initial_omnivores; ++i) {
         m_entityManager.createOmnivore(distX(rng), distY(rng));
     }
+    m_entityManager.destroyDeadEntities(); // Sets up the species ranges (nobody is dead yet)
+
+    // Build the spatial grid so queries (AI, rendering) are valid before the first update
+    #pragma omp parallel
+    updateSpatialGrid();
+}
+
+// Independent random streams used by world generation (see counterRandom)
+enum GenerationStream : uint64_t {
+    STREAM_REGION_BIOME = 1,
+    STREAM_BOUNDARY_BIOME,
+    STREAM_TERRAIN,
+    STREAM_RESOURCE,
+    STREAM_RESOURCE_AMOUNT
+};
+
+// Copies the WFC adjacency rules as bitmasks. A zero-sized generator only carries
+// the rules, so no per-tile WFC grid is allocated.
+static void loadBiomeCompatibility(BiomeMask* compatibility) {
+    WFCGenerator wfc(0, 0, rng);
+    for (int id = 0; id < BIOME_ID_COUNT; ++id) {
+        compatibility[id] = wfc.getCompatibilityMask(static_cast<BiomeId>(id));
+    }
 }
 
 void World::generateBiomes() {
-    // Two-phase approach: Large regions first, then WFC for boundaries
+    // Two-phase approach: Large regions first, then WFC adjacency rules for boundaries.
+    // Every random draw is keyed by tile/region index, so rows are generated in parallel
+    // and the result only depends on m_generation_seed.
     
     // Phase 1: Generate large biome regions using a coarser grid
     const int region_size = 15; // Each region is 15x15 tiles
@@ -68,14 +140,14 @@ void World::generateBiomes() {
     const int regions_y = (height + region_size - 1) / region_size;
     
     // Create a coarse grid of biome regions
-    std::vector<std::vector<const BiomeType*>> region_grid(regions_y, std::vector<const BiomeType*>(regions_x));
-    
-    std::uniform_real_distribution<float> dist_chance(0.0f, 1.0f);
+    std::vector<const BiomeType*> region_grid(static_cast<size_t>(regions_x) * regions_y);
     
     // Assign biomes to regions
+    #pragma omp parallel for schedule(static)
     for (int ry = 0; ry < regions_y; ++ry) {
         for (int rx = 0; rx < regions_x; ++rx) {
-            float chance = dist_chance(rng);
+            int region_index = ry * regions_x + rx;
+            float chance = counterRandomFloat(m_generation_seed, STREAM_REGION_BIOME, region_index);
             
             const BiomeType* region_biome;
             if (chance < 0.15f) {
@@ -92,175 +164,277 @@ void World::generateBiomes() {
                 region_biome = &BIOME_BARREN;
             }
             
-            region_grid[ry][rx] = region_biome;
+            region_grid[region_index] = region_biome;
         }
     }
     
-    // Phase 2: Apply WFC only near region boundaries for smooth transitions
-    WFCGenerator wfc(width, height, rng);
+    // Base biome of a tile is the biome of its region (clamped to valid region indices)
+    auto regionBiome = [&](int x, int y) {
+        int rx = std::min(x / region_size, regions_x - 1);
+        int ry = std::min(y / region_size, regions_y - 1);
+        return region_grid[ry * regions_x + rx];
+    };
+    
+    // Phase 2: Flatten the WFC adjacency rules into bitmasks
+    BiomeMask compatibility[BIOME_ID_COUNT];
+    loadBiomeCompatibility(compatibility);
     
-    // First, assign base biomes from regions
+    // Phase 3: Assign base biomes and smooth boundaries between different regions.
+    // Boundary tiles look at the base (region) biomes of their neighbors rather than already
+    // smoothed tiles, which keeps every tile independent of processing order.
+    #pragma omp parallel for schedule(static)
     for (int y = 0; y < height; ++y) {
         for (int x = 0; x < width; ++x) {
-            int rx = x / region_size;
-            int ry = y / region_size;
+            size_t index = static_cast<size_t>(y) * width + x;
+            const BiomeType* center_biome = regionBiome(x, y);
+            m_tiles.biome_ids[index] = center_biome->id;
             
-            // Clamp to valid region indices
-            rx = std::min(rx, regions_x - 1);
-            ry = std::min(ry, regions_y - 1);
-            
-            grid[y][x].setBiome(region_grid[ry][rx]);
-        }
-    }
-    
-    // Phase 3: Use WFC to smooth boundaries between different regions
-    for (int y = 1; y < height - 1; ++y) {
-        for (int x = 1; x < width - 1; ++x) {
-            // Check if this tile is near a biome boundary
-            const BiomeType* center_biome = grid[y][x].getBiome();
-            bool near_boundary = false;
+            // Edge tiles keep their region biome
+            if (x == 0 || y == 0 || x == width - 1 || y == height - 1) continue;
             
-            // Check 3x3 neighborhood for different biomes
-            for (int dy = -1; dy <= 1 && !near_boundary; ++dy) {
-                for (int dx = -1; dx <= 1 && !near_boundary; ++dx) {
+            // Collect the 8 neighbors' biomes (and the center) as masks
+            BiomeMask neighbor_mask = 0;
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
                     if (dx == 0 && dy == 0) continue;
-                    
-                    int nx = x + dx;
-                    int ny = y + dy;
-                    
-                    if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
-                        if (grid[ny][nx].getBiome() != center_biome) {
-                            near_boundary = true;
-                        }
-                    }
+                    neighbor_mask |= biomeBit(regionBiome(x + dx, y + dy)->id);
                 }
             }
             
-            // If near boundary, use WFC to create natural transition
-            if (near_boundary) {
-                // Get possible transitions based on neighbors
-                std::set<const BiomeType*> neighbor_biomes;
-                for (int dy = -1; dy <= 1; ++dy) {
-                    for (int dx = -1; dx <= 1; ++dx) {
-                        int nx = x + dx;
-                        int ny = y + dy;
-                        
-                        if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
-                            neighbor_biomes.insert(grid[ny][nx].getBiome());
-                        }
-                    }
-                }
-                
-                // Choose a biome that's compatible with neighbors
-                std::vector<const BiomeType*> candidates;
-                for (const BiomeType* candidate : neighbor_biomes) {
-                    bool is_compatible = true;
-                    
-                    // Check if this candidate is compatible with all neighbors
-                    for (int dy = -1; dy <= 1 && is_compatible; ++dy) {
-                        for (int dx = -1; dx <= 1 && is_compatible; ++dx) {
-                            if (dx == 0 && dy == 0) continue;
-                            
-                            int nx = x + dx;
-                            int ny = y + dy;
-                            
-                            if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
-                                const BiomeType* neighbor = grid[ny][nx].getBiome();
-                                
-                                // Check adjacency rules
-                                auto it = wfc.getAdjacencyRules().find(candidate);
-                                if (it != wfc.getAdjacencyRules().end()) {
-                                    if (it->second.find(neighbor) == it->second.end()) {
-                                        is_compatible = false;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    
-                    if (is_compatible) {
-                        candidates.push_back(candidate);
-                    }
-                }
-                
-                // Randomly select from compatible candidates
-                if (!candidates.empty()) {
-                    std::uniform_int_distribution<int> candidate_dist(0, candidates.size() - 1);
-                    grid[y][x].setBiome(candidates[candidate_dist(rng)]);
+            // Check if this tile is near a biome boundary
+            BiomeMask center_mask = biomeBit(center_biome->id);
+            if (neighbor_mask == center_mask) continue;
+            
+            // Candidates are biomes present in the 3x3 neighborhood that are compatible with all neighbors
+            BiomeMask present = neighbor_mask | center_mask;
+            BiomeId candidates[BIOME_ID_COUNT];
+            int candidate_count = 0;
+            for (int id = 0; id < BIOME_ID_COUNT; ++id) {
+                if ((present & (1 << id)) && (neighbor_mask & ~compatibility[id]) == 0) {
+                    candidates[candidate_count++] = static_cast<BiomeId>(id);
                 }
             }
+            
+            // Randomly select from compatible candidates
+            if (candidate_count > 0) {
+                float pick = counterRandomFloat(m_generation_seed, STREAM_BOUNDARY_BIOME, index);
+                int choice = std::min(static_cast<int>(pick * candidate_count), candidate_count - 1);
+                m_tiles.biome_ids[index] = candidates[choice];
+            }
         }
     }
 }
 
+void World::generateNoiseBiomes() {
+    BiomeMask compatibility[BIOME_ID_COUNT];
+    loadBiomeCompatibility(compatibility);
+
+    NoiseGenerator noise(width, height, m_generation_seed, compatibility);
+    noise.generate(m_tiles.biome_ids);
+}
+
 void World::seedResources() {
-    // First, place terrain based on biome terrain distribution
+    // Terrain and resources are placed from each tile's biome distribution.
+    // Tiles are independent (keyed random draws), so rows are processed in parallel.
+    #pragma omp parallel for schedule(static)
     for (int r = 0; r < height; ++r) {
         for (int c = 0; c < width; ++c) {
-            const BiomeType* biome = grid[r][c].getBiome();
-            if (!biome) continue;
+            size_t tile_index = static_cast<size_t>(r) * width + c;
+            const BiomeType* biome = ALL_BIOMES[m_tiles.biome_ids[tile_index]];
 
-            std::uniform_real_distribution<float> dist_chance(0.0f, 1.0f);
-            float chance = dist_chance(rng);
-            float cumulative_prob = 0.0f;
+            // If no terrain is picked, default to normal terrain
+            m_tiles.terrain_ids[tile_index] = TERRAIN_ID_NORMAL;
+            m_tiles.resource_ids[tile_index] = RESOURCE_ID_NONE;
+            m_tiles.resource_amounts[tile_index] = 0.0f;
+            m_tiles.regrowth_timers[tile_index] = 0;
 
             // Place terrain first
+            float chance = counterRandomFloat(m_generation_seed, STREAM_TERRAIN, tile_index);
+            float cumulative_prob = 0.0f;
             for (const auto& pair : biome->terrain_distribution) {
-                const TerrainType* terrain = pair.first;
-                float probability = pair.second;
-                cumulative_prob += probability;
-
+                cumulative_prob += pair.second;
                 if (chance < cumulative_prob) {
-                    grid[r][c].setTerrain(terrain);
+                    m_tiles.terrain_ids[tile_index] = pair.first->id;
                     break;
                 }
             }
 
-            // If no terrain was set, default to normal terrain
-            if (!grid[r][c].getTerrain()) {
-                grid[r][c].setTerrain(&TERRAIN_NORMAL);
+            // Then, place a resource using the biome's resource distribution map
+            chance = counterRandomFloat(m_generation_seed, STREAM_RESOURCE, tile_index);
+            cumulative_prob = 0.0f;
+            for (const auto& pair : biome->resource_distribution) {
+                cumulative_prob += pair.second;
+                if (chance < cumulative_prob) {
+                    // Initial amount is uniform between half and full capacity
+                    const ResourceType* resource = pair.first;
+                    float amount_roll = counterRandomFloat(m_generation_seed, STREAM_RESOURCE_AMOUNT, tile_index);
+                    m_tiles.resource_ids[tile_index] = resource->id;
+                    m_tiles.resource_amounts[tile_index] = resource->max_amount * (0.5f + 0.5f * amount_roll);
+                    break; // Move to the next tile once a resource is placed
+                }
             }
         }
     }
+}
 
-    // Then, place resources based on biome resource distribution
-    std::uniform_real_distribution<float> dist_grass_amount(RESOURCE_GRASS.max_amount / 2, RESOURCE_GRASS.max_amount);
-    std::uniform_real_distribution<float> dist_berry_amount(RESOURCE_BERRIES.max_amount / 2, RESOURCE_BERRIES.max_amount);
-    std::uniform_real_distribution<float> dist_bush_amount(RESOURCE_BUSH.max_amount / 2, RESOURCE_BUSH.max_amount);
+WorldCacheKey World::getWorldCacheKey() const {
+    WorldCacheKey key;
+    key.seed = m_generation_seed;
+    key.width = width;
+    key.height = height;
+    key.generator_type = static_cast<int32_t>(m_generator_type);
+    return key;
+}
 
-    for (int r = 0; r < height; ++r) {
-        for (int c = 0; c < width; ++c) {
-            const BiomeType* biome = grid[r][c].getBiome();
-            if (!biome) continue;
+bool World::loadCachedWorld() {
+    if (m_world_cache_directory.empty()) {
+        return false;
+    }
 
-            std::uniform_real_distribution<float> dist_chance(0.0f, 1.0f);
-            float chance = dist_chance(rng);
-            float cumulative_prob = 0.0f;
+    // The cached layers are read straight into the tile storage
+    WorldCacheKey key = getWorldCacheKey();
+    std::string path = WorldCache::getCachePath(m_world_cache_directory, key);
+    if (!WorldCache::load(path, key, m_tiles)) {
+        return false;
+    }
 
-            // Use the biome's resource distribution map
-            for (const auto& pair : biome->resource_distribution) {
-                const ResourceType* resource = pair.first;
-                float probability = pair.second;
-                cumulative_prob += probability;
+    // Reject IDs outside the type tables rather than indexing past them
+    // (generation then overwrites every layer)
+    size_t tile_count = static_cast<size_t>(width) * height;
+    for (size_t i = 0; i < tile_count; ++i) {
+        if (m_tiles.biome_ids[i] >= BIOME_ID_COUNT || m_tiles.terrain_ids[i] >= TERRAIN_ID_COUNT ||
+            m_tiles.resource_ids[i] >= RESOURCE_ID_COUNT) {
+            std::cerr << "World cache " << path << " contains invalid tile IDs, regenerating." << std::endl;
+            return false;
+        }
+    }
 
-                if (chance < cumulative_prob) {
-                    float initial_amount = 0.0f;
-                    if (resource == &RESOURCE_GRASS) {
-                        initial_amount = dist_grass_amount(rng);
-                    } else if (resource == &RESOURCE_BERRIES) {
-                        initial_amount = dist_berry_amount(rng);
-                    } else if (resource == &RESOURCE_BUSH) {
-                        initial_amount = dist_bush_amount(rng);
-                    }
-                    grid[r][c].setResource(resource, initial_amount);
-                    break; // Move to the next tile once a resource is placed
+    std::cout << "Loaded world from cache: " << path << std::endl;
+    return true;
+}
+
+void World::saveCachedWorld() const {
+    if (m_world_cache_directory.empty()) {
+        return;
+    }
+
+    WorldCacheKey key = getWorldCacheKey();
+    WorldCache::save(WorldCache::getCachePath(m_world_cache_directory, key), key, m_tiles);
+}
+
+// Whether each terrain admits each species (Tile::canMove rules, evaluated once)
+static void loadTerrainPassability(bool passable[TERRAIN_ID_COUNT][ANIMAL_TYPE_COUNT]) {
+    for (int terrain_id = 0; terrain_id < TERRAIN_ID_COUNT; ++terrain_id) {
+        Tile tile;
+        tile.setTerrain(ALL_TERRAINS[terrain_id]);
+        for (int type = 0; type < ANIMAL_TYPE_COUNT; ++type) {
+            passable[terrain_id][type] = tile.canMove(static_cast<AnimalType>(type));
+        }
+    }
+}
+
+static uint8_t encodeTileModifier(float value) {
+    float code = std::round(value * TILE_MODIFIER_ONE);
+    return static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, code)));
+}
+
+// Packed speed/sight modifiers for every (terrain, biome, species) combination
+static void loadTileModifierTable(uint16_t table[TERRAIN_ID_COUNT][BIOME_ID_COUNT][ANIMAL_TYPE_COUNT]) {
+    for (int terrain_id = 0; terrain_id < TERRAIN_ID_COUNT; ++terrain_id) {
+        const TerrainType* terrain = ALL_TERRAINS[terrain_id];
+        for (int biome_id = 0; biome_id < BIOME_ID_COUNT; ++biome_id) {
+            for (int type = 0; type < ANIMAL_TYPE_COUNT; ++type) {
+                float sight = terrain->sight_modifier;
+
+                // Forest sight hindrance for herbivores and omnivores
+                AnimalType animal_type = static_cast<AnimalType>(type);
+                if (biome_id == BIOME_ID_FOREST &&
+                    (animal_type == AnimalType::HERBIVORE || animal_type == AnimalType::OMNIVORE)) {
+                    sight *= FOREST_SIGHT_MODIFIER;
                 }
+
+                table[terrain_id][biome_id][type] = static_cast<uint16_t>(
+                    encodeTileModifier(terrain->speed_modifier) | (encodeTileModifier(sight) << 8));
+            }
+        }
+    }
+}
+
+void World::rebuildTerrainCaches() {
+    bool passable[TERRAIN_ID_COUNT][ANIMAL_TYPE_COUNT];
+    loadTerrainPassability(passable);
+    uint16_t modifier_table[TERRAIN_ID_COUNT][BIOME_ID_COUNT][ANIMAL_TYPE_COUNT];
+    loadTileModifierTable(modifier_table);
+
+    // Each 64-bit word covers 64 consecutive tiles, so words are built independently
+    size_t tile_count = m_tiles.terrain_ids.size();
+    size_t word_count = (tile_count + 63) / 64;
+    for (int type = 0; type < ANIMAL_TYPE_COUNT; ++type) {
+        m_passable[type].assign(word_count, 0);
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (size_t word = 0; word < word_count; ++word) {
+        size_t first = word * 64;
+        size_t last = std::min(first + 64, tile_count);
+        uint64_t bits[ANIMAL_TYPE_COUNT] = {0};
+        for (size_t index = first; index < last; ++index) {
+            const bool* tile_passable = passable[m_tiles.terrain_ids[index]];
+            for (int type = 0; type < ANIMAL_TYPE_COUNT; ++type) {
+                bits[type] |= static_cast<uint64_t>(tile_passable[type]) << (index - first);
             }
         }
+        for (int type = 0; type < ANIMAL_TYPE_COUNT; ++type) {
+            m_passable[type][word] = bits[type];
+        }
+    }
+
+    m_tile_modifiers.resize(tile_count * ANIMAL_TYPE_COUNT);
+    #pragma omp parallel for schedule(static)
+    for (size_t index = 0; index < tile_count; ++index) {
+        const uint16_t* tile_modifiers = modifier_table[m_tiles.terrain_ids[index]][m_tiles.biome_ids[index]];
+        for (int type = 0; type < ANIMAL_TYPE_COUNT; ++type) {
+            m_tile_modifiers[index * ANIMAL_TYPE_COUNT + type] = tile_modifiers[type];
+        }
+    }
+}
+
+void World::updateTerrainCaches(size_t tile_index) {
+    bool passable[TERRAIN_ID_COUNT][ANIMAL_TYPE_COUNT];
+    loadTerrainPassability(passable);
+
+    uint16_t modifier_table[TERRAIN_ID_COUNT][BIOME_ID_COUNT][ANIMAL_TYPE_COUNT];
+    loadTileModifierTable(modifier_table);
+
+    uint64_t bit = static_cast<uint64_t>(1) << (tile_index & 63);
+    const bool* tile_passable = passable[m_tiles.terrain_ids[tile_index]];
+    const uint16_t* tile_modifiers = modifier_table[m_tiles.terrain_ids[tile_index]][m_tiles.biome_ids[tile_index]];
+    for (int type = 0; type < ANIMAL_TYPE_COUNT; ++type) {
+        uint64_t& word = m_passable[type][tile_index >> 6];
+        word = tile_passable[type] ? (word | bit) : (word & ~bit);
+        m_tile_modifiers[tile_index * ANIMAL_TYPE_COUNT + type] = tile_modifiers[type];
     }
 }
 
+void World::setTerrain(int x, int y, TerrainId terrain) {
+    if (x < 0 || x >= width || y < 0 || y >= height) return;
+
+    size_t index = getTileIndex(x, y);
+    m_tiles.terrain_ids[index] = terrain;
+    updateTerrainCaches(index);
+    m_flow_fields.clear(); // Paths through this tile may have changed
+    m_pathfinder.clear();
+}
+
 void World::updateSpatialGrid() {
+    // Filling the cells is serial; the influence fields are then built by the whole team
+    #pragma omp single
+    fillSpatialGrid();
+
+    updateInfluenceFields();
+}
+
+void World::fillSpatialGrid() {
     // 1. Clear the spatial grid from the previous turn
     // Optimized: Use a single loop instead of nested loops
     for (auto& row : spatial_grid) {
@@ -268,6 +442,7 @@ void World::updateSpatialGrid() {
             cell.clear();
         }
     }
+    std::fill(spatial_grid_population.begin(), spatial_grid_population.end(), 0);
 
     // 2. Populate the spatial grid with current entity positions (indices)
     size_t num_entities = m_entityManager.getEntityCount();
@@ -297,105 +472,435 @@ void World::updateSpatialGrid() {
                 cell_y >= 0 && cell_y < spatial_grid_height)
             {
                 spatial_grid[cell_y][cell_x].push_back(i); // <-- Store entity ID (index)
+                spatial_grid_population[(cell_y * spatial_grid_width + cell_x) * ANIMAL_TYPE_COUNT + static_cast<int>(m_entityManager.type[i])]++;
             }
         }
     }
 }
 
-void World::update() {
-    turn_count++;
+void World::markCellChange(int x, int y) {
+    m_cell_change_turns[(y / spatial_grid_cell_size) * spatial_grid_width + x / spatial_grid_cell_size] = turn_count;
+}
 
-    // Phase 0: Animation State Capture (NEW)
-    // Capture all current positions before any logic modifies them.
-    AnimationSystem::capturePreviousPositions(m_entityManager);
+void World::markEntityCellChanges() {
+    const EntityManager& data = m_entityManager;
+    size_t num_entities = data.getEntityCount();
 
-    // Phase 1: Environment & Spatial Grid (Based on positions from END of PREVIOUS turn)
-    updateResources();
-    updateSpatialGrid(); // Relies on positions FROM LAST TURN's Movement
+    for (size_t i = 0; i < num_entities; ++i) {
+        // Newborns and the dead only touch their own cell; movers touch the cells on both sides
+        if (!data.is_alive[i] || data.age[i] == 0) {
+            markCellChange(data.x[i], data.y[i]);
+        } else if (data.x[i] / spatial_grid_cell_size != data.prev_x[i] / spatial_grid_cell_size ||
+                   data.y[i] / spatial_grid_cell_size != data.prev_y[i] / spatial_grid_cell_size) {
+            markCellChange(data.prev_x[i], data.prev_y[i]);
+            markCellChange(data.x[i], data.y[i]);
+        }
+    }
+}
 
+int World::countAnimalsInCells(int x, int y, int radius, AnimalType type) const {
+    int min_cell_x = std::max(0, (x - radius) / spatial_grid_cell_size);
+    int max_cell_x = std::min(spatial_grid_width - 1, (x + radius) / spatial_grid_cell_size);
+    int min_cell_y = std::max(0, (y - radius) / spatial_grid_cell_size);
+    int max_cell_y = std::min(spatial_grid_height - 1, (y + radius) / spatial_grid_cell_size);
 
-    // Phase 2: AI (Decisions for THIS turn)
-    AISystem::run(m_entityManager, *this);
+    int count = 0;
+    for (int cell_y = min_cell_y; cell_y <= max_cell_y; ++cell_y) {
+        for (int cell_x = min_cell_x; cell_x <= max_cell_x; ++cell_x) {
+            count += getSpatialCellPopulation(cell_x, cell_y, type);
+        }
+    }
+    return count;
+}
+
+bool World::hasAreaChangedSince(int x, int y, int radius, int turn) const {
+    int min_cell_x = std::max(0, (x - radius) / spatial_grid_cell_size);
+    int max_cell_x = std::min(spatial_grid_width - 1, (x + radius) / spatial_grid_cell_size);
+    int min_cell_y = std::max(0, (y - radius) / spatial_grid_cell_size);
+    int max_cell_y = std::min(spatial_grid_height - 1, (y + radius) / spatial_grid_cell_size);
+
+    for (int cell_y = min_cell_y; cell_y <= max_cell_y; ++cell_y) {
+        for (int cell_x = min_cell_x; cell_x <= max_cell_x; ++cell_x) {
+            if (m_cell_change_turns[cell_y * spatial_grid_width + cell_x] >= turn) return true;
+        }
+    }
+    return false;
+}
+
+void World::updateInfluenceFields() {
+    #pragma omp single
+    std::fill(m_influence_counts.begin(), m_influence_counts.end(), 0);
 
+    // 1. Scatter: the same living, in-bounds entities as the spatial grid
+    const EntityManager& data = m_entityManager;
+    size_t num_entities = data.getEntityCount();
+    int* counts = m_influence_counts.data();
 
-    // Phase 3: Action (Movement & Combat/Consumption)
-    // MovementSystem::run must run after AI (needs targets/states)
-    MovementSystem::run(m_entityManager, *this);
+    #pragma omp for schedule(static)
+    for (size_t i = 0; i < num_entities; ++i) {
+        if (!data.is_alive[i]) continue;
+        int entity_x = data.x[i];
+        int entity_y = data.y[i];
+        if (entity_x < 0 || entity_x >= width || entity_y < 0 || entity_y >= height) continue;
+
+        size_t cell = static_cast<size_t>(entity_y / INFLUENCE_CELL_SIZE) * influence_grid_width + entity_x / INFLUENCE_CELL_SIZE;
+        #pragma omp atomic
+        counts[cell * ANIMAL_TYPE_COUNT + static_cast<int>(data.type[i])]++;
+    }
 
-    // ActionSystem::run must run after Movement (needs new positions for adjacency)
-    // This is a single-threaded system. Implicit synchronization point here.
-    ActionSystem::run(m_entityManager, *this);
+    // 2. Box sum, separable: sliding windows along rows, then along columns
+    #pragma omp for schedule(static)
+    for (int cell_y = 0; cell_y < influence_grid_height; ++cell_y) {
+        const int* row = &m_influence_counts[static_cast<size_t>(cell_y) * influence_grid_width * ANIMAL_TYPE_COUNT];
+        int* out = &m_influence_row_sums[static_cast<size_t>(cell_y) * influence_grid_width * ANIMAL_TYPE_COUNT];
 
+        for (int type = 0; type < ANIMAL_TYPE_COUNT; ++type) {
+            int window = 0;
+            for (int cell_x = 0; cell_x < std::min(INFLUENCE_BOX_RADIUS, influence_grid_width); ++cell_x) {
+                window += row[cell_x * ANIMAL_TYPE_COUNT + type];
+            }
+            for (int cell_x = 0; cell_x < influence_grid_width; ++cell_x) {
+                int entering = cell_x + INFLUENCE_BOX_RADIUS;
+                int leaving = cell_x - INFLUENCE_BOX_RADIUS - 1;
+                if (entering < influence_grid_width) window += row[entering * ANIMAL_TYPE_COUNT + type];
+                if (leaving >= 0) window -= row[leaving * ANIMAL_TYPE_COUNT + type];
+                out[cell_x * ANIMAL_TYPE_COUNT + type] = window;
+            }
+        }
+    }
 
-    // Phase 4: Post-Action Consequences
-    // MetabolismSystem::run reads results of actions (damage, energy)
-    MetabolismSystem::run(m_entityManager, *this);
+    size_t row_stride = static_cast<size_t>(influence_grid_width) * ANIMAL_TYPE_COUNT;
+    #pragma omp for schedule(static)
+    for (int column = 0; column < influence_grid_width * ANIMAL_TYPE_COUNT; ++column) {
+        const int* in = &m_influence_row_sums[column];
+        int* out = &m_influence_field[column];
 
-    // Cleanup must happen after actions and metabolism finalize who is dead
-    // This is a single-threaded operation that modifies the entity list structure.
-    // Implicit synchronization point here.
-    m_entityManager.destroyDeadEntities();
+        int window = 0;
+        for (int cell_y = 0; cell_y < std::min(INFLUENCE_BOX_RADIUS, influence_grid_height); ++cell_y) {
+            window += in[cell_y * row_stride];
+        }
+        for (int cell_y = 0; cell_y < influence_grid_height; ++cell_y) {
+            int entering = cell_y + INFLUENCE_BOX_RADIUS;
+            int leaving = cell_y - INFLUENCE_BOX_RADIUS - 1;
+            if (entering < influence_grid_height) window += in[entering * row_stride];
+            if (leaving >= 0) window -= in[leaving * row_stride];
+            out[cell_y * row_stride] = window;
+        }
+    }
+}
 
-    // Reproduction happens from survivors after cleanup
-    // This is a single-threaded operation that modifies the entity list structure.
-    // Implicit synchronization point here.
-    ReproductionSystem::run(m_entityManager);
+void World::update() {
+    turn_count++;
+    m_entityManager.beginTurn(); // Reset per-turn birth/death tallies
+    m_worker_pool.beginTurn();   // Release last turn's scratch memory
+
+    // The whole turn runs in one parallel region: every thread walks through the phases below,
+    // sharing the parallel loops and leaving the serial steps to one thread ("omp single").
+    // Each phase ends in a barrier (implicit at the end of a loop or single), so the next
+    // phase sees its results. No thread team is started or joined inside the turn.
+    #pragma omp parallel
+    {
+        // Phase 0: Animation State Capture (NEW)
+        // Capture all current positions before any logic modifies them.
+        AnimationSystem::capturePreviousPositions(m_entityManager);
+
+        // Phase 1: Environment
+        // The spatial grid already holds the positions from the END of the PREVIOUS turn
+        // (rebuilt after cleanup/reproduction below, or by init() for the first turn).
+        updateResources();
+        updateScentFields();
+
+
+        // Phase 2: AI (Decisions for THIS turn)
+        AISystem::run(m_entityManager, *this, m_worker_pool, &m_ai_thread_stats);
+
+
+        // Phase 3: Action (Movement & Combat/Consumption)
+        // MovementSystem::run must run after AI (needs targets/states)
+        // The routes and flow fields for this turn's goals are built first, so movement only reads them.
+        // Only what is missing from the caches is built, shared by the team.
+        MovementSystem::preparePathing(m_entityManager, *this, m_worker_pool);
+        MovementSystem::run(m_entityManager, *this);
+
+        // ActionSystem::run must run after Movement (needs new positions for adjacency)
+        // This is a single-threaded system.
+        #pragma omp single
+        ActionSystem::run(m_entityManager, *this);
+
+
+        // Phase 4: Post-Action Consequences
+        // MetabolismSystem::run reads results of actions (damage, energy)
+        MetabolismSystem::run(m_entityManager, *this, m_worker_pool, &m_metabolism_thread_stats);
+
+        #pragma omp single
+        {
+            // Reproduction happens from the living (dead entities are skipped); newborns are appended
+            // This is a single-threaded operation that modifies the entity list structure.
+            ReproductionSystem::run(m_entityManager);
+
+            // Cells that gained or lost entities are stamped before cleanup drops the dead
+            markEntityCellChanges();
+
+            // Cleanup must happen after actions and metabolism finalize who is dead. It also regroups
+            // the entities (newborns included) by species, which the per-species system loops rely on.
+            // Its column copies are tasks, run by the threads waiting at the end of this single.
+            m_entityManager.destroyDeadEntities();
+        }
 
-    // Next turn's Spatial Grid update (Phase 1) will use the positions
-    // resulting from THIS turn's Movement. This requires positions to be stable
-    // throughout Cleanup and Reproduction.
+        // Phase 5: Spatial Grid
+        // Rebuilt only once the entity list is final for this turn, so the stored IDs match
+        // the post-cleanup indices. Both next turn's AI and the renderer query this snapshot.
+        updateSpatialGrid();
+    }
 }
 
 bool World::isEcosystemCollapsed() const {
     const EntityManager& data = getEntityManager();
-    size_t num_entities = data.getEntityCount();
 
-    if (num_entities == 0) {
+    if (data.getEntityCount() == 0) {
         return true; // No entities left
     }
 
-    int herbivore_count = 0;
-    int carnivore_count = 0;
-    int omnivore_count = 0;
+    // The ecosystem is considered collapsed if any one species is completely wiped out (has 0 living members).
+    // Counts are maintained incrementally by the EntityManager, so no scan is needed.
+    return (data.getAliveCount(AnimalType::HERBIVORE) == 0 ||
+            data.getAliveCount(AnimalType::CARNIVORE) == 0 ||
+            data.getAliveCount(AnimalType::OMNIVORE) == 0);
+}
+
+
+void World::updateScentFields() {
+    // 1. Count prey per tile (integer atomics, so the result does not depend on thread order)
+    const EntityManager& data = m_entityManager;
+    size_t num_entities = data.getEntityCount();
+    int* herbivore_deposits = m_scent_deposits[SCENT_HERBIVORE].data();
+    int* omnivore_deposits = m_scent_deposits[SCENT_OMNIVORE].data();
 
-    // Iterate through all entities in the EntityManager
+    #pragma omp for schedule(static)
     for (size_t i = 0; i < num_entities; ++i) {
-        // We only count living entities for population checks
-        if (data.is_alive[i]) {
-            switch (data.type[i]) {
-                case AnimalType::HERBIVORE:
-                    herbivore_count++;
-                    break;
-                case AnimalType::CARNIVORE:
-                    carnivore_count++;
-                    break;
-                case AnimalType::OMNIVORE:
-                    omnivore_count++;
-                    break;
-                default:
-                    // Should not happen with known types
-                    break;
+        if (!data.is_alive[i] || data.type[i] == AnimalType::CARNIVORE) continue;
+        if (data.x[i] < 0 || data.x[i] >= width || data.y[i] < 0 || data.y[i] >= height) continue;
+        int* deposits = data.type[i] == AnimalType::HERBIVORE ? herbivore_deposits : omnivore_deposits;
+        #pragma omp atomic
+        deposits[getTileIndex(data.x[i], data.y[i])]++;
+    }
+
+    // 2. One explicit diffusion step with decay, fused with the deposit:
+    //    next = DECAY * ((1 - DIFFUSION) * center + DIFFUSION / 4 * (north + south + west + east)) + DEPOSIT * count
+    // Missing neighbors at the map edge are replaced by the center, so no scent leaks off the map.
+    const float keep = SCENT_DECAY * (1.0f - SCENT_DIFFUSION);
+    const float spread = SCENT_DECAY * SCENT_DIFFUSION * 0.25f;
+
+    for (int field = 0; field < SCENT_FIELD_COUNT; ++field) {
+        const float* scent = m_scent[field].data();
+        int* deposits = m_scent_deposits[field].data();
+        float* next = m_scent_next.data();
+
+        #pragma omp for schedule(static)
+        for (int y = 0; y < height; ++y) {
+            size_t row_start = static_cast<size_t>(y) * width;
+            const float* row = scent + row_start;
+            const float* north = y > 0 ? row - width : row;
+            const float* south = y < height - 1 ? row + width : row;
+            int* row_deposits = deposits + row_start;
+            float* out = next + row_start;
+
+            // Edge columns
+            for (int x : {0, width - 1}) {
+                float west = x > 0 ? row[x - 1] : row[x];
+                float east = x < width - 1 ? row[x + 1] : row[x];
+                out[x] = keep * row[x] + spread * (north[x] + south[x] + west + east) + SCENT_DEPOSIT * row_deposits[x];
             }
+
+            #pragma omp simd
+            for (int x = 1; x < width - 1; ++x) {
+                out[x] = keep * row[x] + spread * (north[x] + south[x] + row[x - 1] + row[x + 1]) + SCENT_DEPOSIT * row_deposits[x];
+            }
+            std::fill(row_deposits, row_deposits + width, 0);
         }
+        #pragma omp single
+        m_scent[field].swap(m_scent_next);
     }
-
-    // The ecosystem is considered collapsed if any one species is completely wiped out (has 0 living members).
-    return (herbivore_count == 0 || carnivore_count == 0 || omnivore_count == 0);
 }
 
-
 // --- These functions are still valid ---
+// Above this share of regrowing tiles, one contiguous SIMD sweep over the whole grid is
+// cheaper than scattered updates through the active set
+const float DENSE_REGROWTH_ACTIVE_FRACTION = 0.125f;
+
 void World::updateResources() {
-    for (int r = 0; r < height; ++r) {
-        for (int c = 0; c < width; ++c) {
-            grid[r][c].regrow();
+    float* amounts = m_tiles.resource_amounts.data();
+
+    // Every thread must take the same branch, so the set is only changed after all have looked
+    bool dense = m_regrowing_tiles.size() > DENSE_REGROWTH_ACTIVE_FRACTION * m_tiles.resource_amounts.size();
+    #pragma omp barrier
+
+    if (dense) {
+        regrowAllTiles();
+
+        // Drop the tiles that reached their cap from the active set
+        #pragma omp single
+        {
+            size_t kept = 0;
+            for (uint32_t index : m_regrowing_tiles) {
+                if (amounts[index] >= m_tile_max_amount[index]) {
+                    m_tile_regrowing[index] = 0;
+                } else {
+                    m_regrowing_tiles[kept++] = index;
+                }
+            }
+            m_regrowing_tiles.resize(kept);
         }
+        rebuildFoodPyramid();
+        return;
     }
+
+    // Only tiles below their cap can change, so regrowth walks the active set instead of
+    // every tile. Tiles are dropped from the set (swap-and-pop) once they reach the cap.
+    #pragma omp single
+    regrowActiveTiles();
 }
 
-std::vector<size_t> World::getAnimalsNear(const EntityManager& data, int x, int y, int radius, AnimalType target_type) const {
-    std::vector<size_t> nearby_ids;
-    if (radius < 0) return nearby_ids; // Invalid radius
+void World::regrowActiveTiles() {
+    float* amounts = m_tiles.resource_amounts.data();
+    size_t i = 0;
+    while (i < m_regrowing_tiles.size()) {
+        uint32_t index = m_regrowing_tiles[i];
+        amounts[index] = std::min(amounts[index] + m_tile_regrowth_rate[index], m_tile_max_amount[index]); // Don't exceed max
+        updateFoodPyramid(index);
+
+        if (amounts[index] >= m_tile_max_amount[index]) {
+            m_tile_regrowing[index] = 0;
+            m_regrowing_tiles[i] = m_regrowing_tiles.back();
+            m_regrowing_tiles.pop_back();
+        } else {
+            ++i;
+        }
+    }
+}
+
+void World::regrowAllTiles() {
+    // amount = min(amount + rate, cap) for every tile. Full tiles stay at their cap and tiles
+    // without a resource have rate = cap = 0, so no masking is needed.
+    #pragma omp for schedule(static)
+    for (int y = 0; y < height; ++y) {
+        size_t row_start = static_cast<size_t>(y) * width;
+        float* amounts = m_tiles.resource_amounts.data() + row_start;
+        const float* rates = m_tile_regrowth_rate.data() + row_start;
+        const float* caps = m_tile_max_amount.data() + row_start;
+
+        #pragma omp simd
+        for (int x = 0; x < width; ++x) {
+            float grown = amounts[x] + rates[x];
+            amounts[x] = caps[x] < grown ? caps[x] : grown; // std::min as a select, so the loop vectorizes
+        }
+    }
+}
+
+void World::rebuildRegrowingTiles() {
+    size_t tile_count = m_tiles.resource_amounts.size();
+    m_tile_regrowing.assign(tile_count, 0);
+    m_regrowing_tiles.clear();
+    m_tile_regrowth_rate.assign(tile_count, 0.0f);
+    m_tile_max_amount.assign(tile_count, 0.0f);
+
+    for (size_t index = 0; index < tile_count; ++index) {
+        const ResourceType* resource = ALL_RESOURCES[m_tiles.resource_ids[index]];
+        if (!resource) continue;
+
+        m_tile_regrowth_rate[index] = resource->regrowth_rate;
+        m_tile_max_amount[index] = resource->max_amount;
+        if (m_tiles.resource_amounts[index] < resource->max_amount) {
+            m_tile_regrowing[index] = 1;
+            m_regrowing_tiles.push_back(static_cast<uint32_t>(index));
+        }
+    }
+}
+
+// Maximum over the (up to four) children of block (block_x, block_y) on the level below
+static float maxOfChildBlocks(const std::vector<float>& below, int below_width, int below_height, int block_x, int block_y) {
+    int child_x = block_x * 2;
+    int child_y = block_y * 2;
+    const float* row = &below[static_cast<size_t>(child_y) * below_width];
+    bool has_right = child_x + 1 < below_width;
+
+    float result = row[child_x];
+    if (has_right) result = std::max(result, row[child_x + 1]);
+    if (child_y + 1 < below_height) {
+        row += below_width;
+        result = std::max(result, row[child_x]);
+        if (has_right) result = std::max(result, row[child_x + 1]);
+    }
+    return result;
+}
+
+void World::rebuildFoodPyramid() {
+    // Level sizes only depend on the map size, so the levels are laid out once. There are
+    // always at least two levels, since searches start on level 1.
+    #pragma omp single
+    if (m_food_pyramid.empty()) {
+        int level_width = width;
+        int level_height = height;
+        while (true) {
+            m_food_pyramid.emplace_back(static_cast<size_t>(level_width) * level_height, 0.0f);
+            m_food_pyramid_widths.push_back(level_width);
+            if (level_width <= 1 && level_height <= 1 && m_food_pyramid.size() > 1) break;
+            level_width = (level_width + 1) / 2;
+            level_height = (level_height + 1) / 2;
+        }
+    }
+
+    const float* amounts = m_tiles.resource_amounts.data();
+    const uint8_t* resource_ids = m_tiles.resource_ids.data();
+    float* food = m_food_pyramid[0].data();
+    size_t tile_count = m_tiles.resource_amounts.size();
+
+    #pragma omp for schedule(static)
+    for (size_t index = 0; index < tile_count; ++index) {
+        food[index] = amounts[index] * m_resource_nutrition[resource_ids[index]];
+    }
+
+    int below_height = height;
+    for (size_t level = 1; level < m_food_pyramid.size(); ++level) {
+        const std::vector<float>& below = m_food_pyramid[level - 1];
+        int below_width = m_food_pyramid_widths[level - 1];
+        int level_width = m_food_pyramid_widths[level];
+        int level_height = (below_height + 1) / 2;
+        std::vector<float>& blocks = m_food_pyramid[level];
+
+        #pragma omp for schedule(static)
+        for (int block_y = 0; block_y < level_height; ++block_y) {
+            for (int block_x = 0; block_x < level_width; ++block_x) {
+                blocks[static_cast<size_t>(block_y) * level_width + block_x] =
+                    maxOfChildBlocks(below, below_width, below_height, block_x, block_y);
+            }
+        }
+        below_height = level_height;
+    }
+}
+
+void World::updateFoodPyramid(size_t tile_index) {
+    m_food_pyramid[0][tile_index] = m_tiles.resource_amounts[tile_index] * m_resource_nutrition[m_tiles.resource_ids[tile_index]];
+
+    int block_x = static_cast<int>(tile_index % width);
+    int block_y = static_cast<int>(tile_index / width);
+    int below_height = height;
+    for (size_t level = 1; level < m_food_pyramid.size(); ++level) {
+        block_x /= 2;
+        block_y /= 2;
+        float block_max = maxOfChildBlocks(m_food_pyramid[level - 1], m_food_pyramid_widths[level - 1], below_height, block_x, block_y);
+
+        // Once a block's maximum is unchanged, none of its ancestors can change either
+        float& stored = m_food_pyramid[level][static_cast<size_t>(block_y) * m_food_pyramid_widths[level] + block_x];
+        if (stored == block_max) break;
+        stored = block_max;
+        below_height = (below_height + 1) / 2;
+    }
+}
+
+ScratchSpan<size_t> World::getAnimalsNear(const EntityManager& data, int x, int y, int radius, AnimalType target_type, ScratchArena& arena) const {
+    ScratchSpan<size_t> nearby;
+    if (radius < 0) return nearby; // Invalid radius
 
     int radius_sq = radius * radius;
 
@@ -405,10 +910,15 @@ std::vector<size_t> World::getAnimalsNear(const EntityManager& data, int x, int
     int start_cell_y = std::max(0, (y - radius) / spatial_grid_cell_size);
     int end_cell_y   = std::min(spatial_grid_height - 1, (y + radius) / spatial_grid_cell_size);
 
-    // Pre-allocate result vector based on estimated capacity
-    // Conservative estimate: assume ~3 entities per cell in search area
-    int search_area_cells = (end_cell_x - start_cell_x + 1) * (end_cell_y - start_cell_y + 1);
-    nearby_ids.reserve(search_area_cells * 3);
+    // Room for every entity in the searched cells, so the ids can be written in one pass
+    size_t capacity = 0;
+    for (int cell_y = start_cell_y; cell_y <= end_cell_y; ++cell_y) {
+        for (int cell_x = start_cell_x; cell_x <= end_cell_x; ++cell_x) {
+            capacity += spatial_grid[cell_y][cell_x].size();
+        }
+    }
+    size_t* nearby_ids = arena.allocate<size_t>(capacity);
+    nearby.values = nearby_ids;
 
     for (int cell_y = start_cell_y; cell_y <= end_cell_y; ++cell_y) {
         for (int cell_x = start_cell_x; cell_x <= end_cell_x; ++cell_x) {
@@ -422,29 +932,60 @@ std::vector<size_t> World::getAnimalsNear(const EntityManager& data, int x, int
                     int dx = data.x[entity_id] - x;
                     int dy = data.y[entity_id] - y;
                     if (dx * dx + dy * dy <= radius_sq) {
-                        nearby_ids.push_back(entity_id);
+                        nearby_ids[nearby.count++] = entity_id;
                     }
                 }
             }
         }
     }
-    return nearby_ids;
+    return nearby;
 }
 
-Tile& World::getTile(int x, int y) {
-    if (x >= 0 && x < width && y >= 0 && y < height) {
-        return grid[y][x];
+void World::getEntitiesInArea(int min_x, int min_y, int max_x, int max_y, std::vector<size_t>& out_ids) const {
+    if (max_x < 0 || max_y < 0 || min_x >= width || min_y >= height) return; // Entirely off the map
+
+    int start_cell_x = std::max(0, min_x / spatial_grid_cell_size);
+    int end_cell_x   = std::min(spatial_grid_width - 1, max_x / spatial_grid_cell_size);
+    int start_cell_y = std::max(0, min_y / spatial_grid_cell_size);
+    int end_cell_y   = std::min(spatial_grid_height - 1, max_y / spatial_grid_cell_size);
+
+    for (int cell_y = start_cell_y; cell_y <= end_cell_y; ++cell_y) {
+        for (int cell_x = start_cell_x; cell_x <= end_cell_x; ++cell_x) {
+            const auto& cell = spatial_grid[cell_y][cell_x];
+            out_ids.insert(out_ids.end(), cell.begin(), cell.end());
+        }
     }
-    static Tile empty_tile;
-    return empty_tile;
 }
 
-const Tile& World::getTile(int x, int y) const {
+Tile World::getTile(int x, int y) const {
+    Tile tile;
     if (x >= 0 && x < width && y >= 0 && y < height) {
-        return grid[y][x];
+        size_t index = getTileIndex(x, y);
+        tile.resource_type = ALL_RESOURCES[m_tiles.resource_ids[index]];
+        tile.resource_amount = m_tiles.resource_amounts[index];
+        tile.biome_type = ALL_BIOMES[m_tiles.biome_ids[index]];
+        tile.terrain_type = ALL_TERRAINS[m_tiles.terrain_ids[index]];
+        tile.regrowth_timer = m_tiles.regrowth_timers[index];
+    }
+    return tile;
+}
+
+float World::consumeResource(int x, int y, float amount_requested) {
+    size_t index = getTileIndex(x, y);
+    float& amount = m_tiles.resource_amounts[index];
+    float amount_consumed = std::min(amount_requested, amount);
+    amount -= amount_consumed;
+
+    // Tiles with a resource type below their cap need regrowth
+    if (amount_consumed > 0.0f && !m_tile_regrowing[index] && m_tiles.resource_ids[index] != RESOURCE_ID_NONE) {
+        m_tile_regrowing[index] = 1;
+        m_regrowing_tiles.push_back(static_cast<uint32_t>(index));
+    }
+    if (amount_consumed > 0.0f) {
+        updateFoodPyramid(index);
+        if (amount <= 0.0f) markCellChange(x, y); // Decisions targeting this tile must be redone
     }
-    static const Tile empty_tile_const;
-    return empty_tile_const;
+    return amount_consumed;
 }
 
 int World::calculateOptimalCellSize() const {
@@ -0,0 +1,131 @@
+#include "core/WorldCache.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+const char WORLD_CACHE_MAGIC[8] = {'E', 'C', 'O', 'W', 'O', 'R', 'L', 'D'};
+const uint32_t WORLD_CACHE_FORMAT_VERSION = 1;
+
+struct WorldCacheFileHeader {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t generator_version;
+    uint64_t seed;
+    int32_t width;
+    int32_t height;
+    int32_t generator_type;
+    uint8_t reserved[28];
+};
+static_assert(sizeof(WorldCacheFileHeader) == 64, "World cache header must stay 64 bytes");
+
+// The float layer starts at the first 4-byte boundary after the three byte layers
+static size_t getAmountsOffset(size_t tile_count) {
+    size_t offset = sizeof(WorldCacheFileHeader) + 3 * tile_count;
+    return (offset + 3) & ~static_cast<size_t>(3);
+}
+
+std::string WorldCache::getCachePath(const std::string& directory, const WorldCacheKey& key) {
+    std::ostringstream path;
+    if (!directory.empty()) {
+        path << directory;
+        char last = directory.back();
+        if (last != '/' && last != '\\') path << '/';
+    }
+    path << "world_" << key.width << "x" << key.height << "_g" << key.generator_type
+         << "_" << std::hex << key.seed << ".bin";
+    return path.str();
+}
+
+bool WorldCache::load(const std::string& path, const WorldCacheKey& key, TileLayers& out_layers) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false; // No cache yet, not an error
+    }
+
+    WorldCacheFileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        std::cerr << "World cache " << path << " is truncated, regenerating." << std::endl;
+        return false;
+    }
+
+    if (std::memcmp(header.magic, WORLD_CACHE_MAGIC, sizeof(WORLD_CACHE_MAGIC)) != 0) {
+        std::cerr << "World cache " << path << " is not a world cache file, regenerating." << std::endl;
+        return false;
+    }
+
+    if (header.format_version != WORLD_CACHE_FORMAT_VERSION ||
+        header.generator_version != WORLD_GENERATOR_VERSION) {
+        std::cerr << "World cache " << path << " is from another version, regenerating." << std::endl;
+        return false;
+    }
+
+    if (header.seed != key.seed || header.width != key.width || header.height != key.height ||
+        header.generator_type != key.generator_type) {
+        std::cerr << "World cache " << path << " does not match the requested world, regenerating." << std::endl;
+        return false;
+    }
+
+    size_t tile_count = static_cast<size_t>(key.width) * key.height;
+    out_layers.resize(tile_count);
+
+    file.read(reinterpret_cast<char*>(out_layers.biome_ids.data()), tile_count);
+    file.read(reinterpret_cast<char*>(out_layers.terrain_ids.data()), tile_count);
+    file.read(reinterpret_cast<char*>(out_layers.resource_ids.data()), tile_count);
+    file.seekg(getAmountsOffset(tile_count));
+    file.read(reinterpret_cast<char*>(out_layers.resource_amounts.data()), tile_count * sizeof(float));
+
+    if (!file) {
+        std::cerr << "World cache " << path << " is truncated, regenerating." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool WorldCache::save(const std::string& path, const WorldCacheKey& key, const TileLayers& layers) {
+    size_t tile_count = static_cast<size_t>(key.width) * key.height;
+
+    WorldCacheFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, WORLD_CACHE_MAGIC, sizeof(WORLD_CACHE_MAGIC));
+    header.format_version = WORLD_CACHE_FORMAT_VERSION;
+    header.generator_version = WORLD_GENERATOR_VERSION;
+    header.seed = key.seed;
+    header.width = key.width;
+    header.height = key.height;
+    header.generator_type = key.generator_type;
+
+    // Write to a temporary file first so an interrupted run never leaves a partial cache behind
+    std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "Error writing world cache " << temp_path << std::endl;
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(layers.biome_ids.data()), tile_count);
+        file.write(reinterpret_cast<const char*>(layers.terrain_ids.data()), tile_count);
+        file.write(reinterpret_cast<const char*>(layers.resource_ids.data()), tile_count);
+
+        static const char padding[4] = {0, 0, 0, 0};
+        size_t padding_size = getAmountsOffset(tile_count) - (sizeof(header) + 3 * tile_count);
+        file.write(padding, padding_size);
+        file.write(reinterpret_cast<const char*>(layers.resource_amounts.data()), tile_count * sizeof(float));
+
+        if (!file) {
+            std::cerr << "Error writing world cache " << temp_path << std::endl;
+            return false;
+        }
+    }
+
+    std::remove(path.c_str()); // rename does not overwrite on Windows
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        std::cerr << "Error moving world cache into place: " << path << std::endl;
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
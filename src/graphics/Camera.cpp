@@ -1,10 +1,11 @@
 #include "graphics/Camera.h"
 #include "core/EntityManager.h"
+#include "core/World.h"
 #include <algorithm>
 #include <cmath>
 
 Camera::Camera(unsigned int window_width, unsigned int window_height, int world_width, int world_height, int tile_size) 
-    : m_mode(CameraMode::NORMAL), m_selected_entity(INVALID_ENTITY), m_has_selection(false) {
+    : m_mode(CameraMode::NORMAL), m_selected_entity(INVALID_ENTITY), m_selected_uid(0), m_has_selection(false), m_is_box_selecting(false) {
     initialize(window_width, window_height, world_width, world_height, tile_size);
 }
 
@@ -46,7 +47,7 @@ void Camera::pan(const sf::Vector2f& delta) {
     updateView();
 }
 
-void Camera::handleEvent(const sf::Event& event, sf::RenderWindow& window, const EntityManager* entityManager) {
+void Camera::handleEvent(const sf::Event& event, sf::RenderWindow& window, const World* world) {
     if (event.type == sf::Event::MouseWheelScrolled) {
         if (event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel) {
             float zoom_factor = (event.mouseWheelScroll.delta > 0) ? 0.9f : 1.1f;
@@ -58,14 +59,14 @@ void Camera::handleEvent(const sf::Event& event, sf::RenderWindow& window, const
     if (event.type == sf::Event::MouseButtonPressed) {
         if (event.mouseButton.button == sf::Mouse::Left) {
             // Check for entity selection before starting drag
-            if (entityManager) {
+            if (world) {
                 sf::Vector2i mouse_pos = sf::Mouse::getPosition(window);
                 sf::Vector2f world_pos = window.mapPixelToCoords(mouse_pos, m_view);
                 
-                size_t clicked_entity = findEntityAtPosition(world_pos, entityManager);
+                size_t clicked_entity = findEntityAtPosition(world_pos, world);
                 if (clicked_entity != INVALID_ENTITY) {
                     // Entity clicked - select it and enter follow mode
-                    setFollowTarget(clicked_entity);
+                    setFollowTarget(clicked_entity, world->getEntityManager().uid[clicked_entity]);
                     return; // Don't start dragging when selecting an entity
                 } else {
                     // Empty space clicked - clear selection and return to normal mode
@@ -76,15 +77,32 @@ void Camera::handleEvent(const sf::Event& event, sf::RenderWindow& window, const
             // Start dragging if no entity was selected
             m_is_dragging = true;
             m_last_mouse_pos = sf::Mouse::getPosition(window);
+        } else if (event.mouseButton.button == sf::Mouse::Right) {
+            // Start a box selection at the cursor
+            m_is_box_selecting = true;
+            m_box_start = window.mapPixelToCoords(sf::Mouse::getPosition(window), m_view);
+            m_box_end = m_box_start;
         }
     }
 
     if (event.type == sf::Event::MouseButtonReleased) {
         if (event.mouseButton.button == sf::Mouse::Left) {
             m_is_dragging = false;
+        } else if (event.mouseButton.button == sf::Mouse::Right && m_is_box_selecting) {
+            m_is_box_selecting = false;
+            m_box_end = window.mapPixelToCoords(sf::Mouse::getPosition(window), m_view);
+            m_box_selection = findEntitiesInRect(getBoxSelectionRect(), world);
+            m_box_selection_uids.clear();
+            for (size_t entity_id : m_box_selection) {
+                m_box_selection_uids.push_back(world->getEntityManager().uid[entity_id]);
+            }
         }
     }
 
+    if (event.type == sf::Event::MouseMoved && m_is_box_selecting) {
+        m_box_end = window.mapPixelToCoords(sf::Mouse::getPosition(window), m_view);
+    }
+
     if (event.type == sf::Event::MouseMoved && m_is_dragging) {
         // Manual dragging should exit follow mode
         if (m_mode == CameraMode::ENTITY_FOLLOW) {
@@ -132,6 +150,10 @@ const sf::View& Camera::getView() const {
     return m_view;
 }
 
+float Camera::getZoomLevel() const {
+    return m_zoom_level;
+}
+
 void Camera::updateView() {
     sf::Vector2f view_size(m_window_width * m_zoom_level, m_window_height * m_zoom_level);
     m_view.setSize(view_size);
@@ -198,8 +220,33 @@ CameraMode Camera::getMode() const {
     return m_mode;
 }
 
-void Camera::setFollowTarget(size_t entity_id) {
+void Camera::refreshSelection(const EntityManager* entityManager) {
+    if (!entityManager) return;
+    size_t entity_count = entityManager->getEntityCount();
+
+    if (m_has_selection && (m_selected_entity >= entity_count || entityManager->uid[m_selected_entity] != m_selected_uid)) {
+        m_selected_entity = entityManager->findEntity(m_selected_uid); // INVALID_ENTITY_ID once destroyed
+    }
+
+    // Box selections drop entities that were destroyed
+    size_t kept = 0;
+    for (size_t k = 0; k < m_box_selection.size(); ++k) {
+        size_t entity_id = m_box_selection[k];
+        if (entity_id >= entity_count || entityManager->uid[entity_id] != m_box_selection_uids[k]) {
+            entity_id = entityManager->findEntity(m_box_selection_uids[k]);
+            if (entity_id == INVALID_ENTITY_ID) continue;
+        }
+        m_box_selection[kept] = entity_id;
+        m_box_selection_uids[kept] = m_box_selection_uids[k];
+        kept++;
+    }
+    m_box_selection.resize(kept);
+    m_box_selection_uids.resize(kept);
+}
+
+void Camera::setFollowTarget(size_t entity_id, uint64_t entity_uid) {
     m_selected_entity = entity_id;
+    m_selected_uid = entity_uid;
     m_has_selection = true;
     m_mode = CameraMode::ENTITY_FOLLOW;
 }
@@ -240,10 +287,30 @@ bool Camera::hasSelectedEntity() const {
     return m_has_selection;
 }
 
-size_t Camera::findEntityAtPosition(const sf::Vector2f& world_pos, const EntityManager* entityManager) const {
-    if (!entityManager) {
+bool Camera::isBoxSelecting() const {
+    return m_is_box_selecting;
+}
+
+sf::FloatRect Camera::getBoxSelectionRect() const {
+    float left = std::min(m_box_start.x, m_box_end.x);
+    float top = std::min(m_box_start.y, m_box_end.y);
+    return sf::FloatRect(left, top, std::abs(m_box_end.x - m_box_start.x), std::abs(m_box_end.y - m_box_start.y));
+}
+
+const std::vector<size_t>& Camera::getBoxSelection() const {
+    return m_box_selection;
+}
+
+void Camera::clearBoxSelection() {
+    m_box_selection.clear();
+    m_box_selection_uids.clear();
+}
+
+size_t Camera::findEntityAtPosition(const sf::Vector2f& world_pos, const World* world) const {
+    if (!world) {
         return INVALID_ENTITY;
     }
+    const EntityManager& entityManager = world->getEntityManager();
     
     // Convert world pixel position to tile coordinates
     float tile_x = world_pos.x / m_tile_size;
@@ -252,27 +319,72 @@ size_t Camera::findEntityAtPosition(const sf::Vector2f& world_pos, const EntityM
     // Selection radius in tiles (allows some tolerance for clicking)
     float selection_radius = 0.5f;
     
+    // Only look at the spatial grid cells around the click instead of every entity.
+    // The grid is the end-of-turn snapshot the renderer draws from.
+    std::vector<size_t> candidates;
+    world->getEntitiesInArea(static_cast<int>(std::floor(tile_x - selection_radius)),
+                             static_cast<int>(std::floor(tile_y - selection_radius)),
+                             static_cast<int>(std::ceil(tile_x + selection_radius)),
+                             static_cast<int>(std::ceil(tile_y + selection_radius)),
+                             candidates);
+    
     // Find the closest entity within selection radius
     size_t closest_entity = INVALID_ENTITY;
     float closest_distance = selection_radius;
     
-    for (size_t i = 0; i < entityManager->getEntityCount(); ++i) {
-        if (!entityManager->is_alive[i]) {
+    for (size_t i : candidates) {
+        if (i >= entityManager.getEntityCount() || !entityManager.is_alive[i]) {
             continue;
         }
         
-        float entity_x = static_cast<float>(entityManager->x[i]);
-        float entity_y = static_cast<float>(entityManager->y[i]);
+        float entity_x = static_cast<float>(entityManager.x[i]);
+        float entity_y = static_cast<float>(entityManager.y[i]);
         
         float dx = tile_x - entity_x;
         float dy = tile_y - entity_y;
         float distance = std::sqrt(dx * dx + dy * dy);
         
-        if (distance < closest_distance) {
+        // Prefer the lowest ID on ties, matching the order of a full scan
+        if (distance < closest_distance ||
+            (distance == closest_distance && closest_entity != INVALID_ENTITY && i < closest_entity)) {
             closest_distance = distance;
             closest_entity = i;
         }
     }
     
     return closest_entity;
-}
\ No newline at end of file
+}
+
+std::vector<size_t> Camera::findEntitiesInRect(const sf::FloatRect& world_rect, const World* world) const {
+    std::vector<size_t> selected;
+    if (!world) {
+        return selected;
+    }
+    const EntityManager& entityManager = world->getEntityManager();
+
+    // Rectangle in (fractional) tile coordinates
+    float min_tile_x = world_rect.left / m_tile_size;
+    float min_tile_y = world_rect.top / m_tile_size;
+    float max_tile_x = (world_rect.left + world_rect.width) / m_tile_size;
+    float max_tile_y = (world_rect.top + world_rect.height) / m_tile_size;
+
+    // Same query path as single-click picking: gather the overlapping grid cells, then test exactly
+    std::vector<size_t> candidates;
+    world->getEntitiesInArea(static_cast<int>(std::floor(min_tile_x)), static_cast<int>(std::floor(min_tile_y)),
+                             static_cast<int>(std::ceil(max_tile_x)), static_cast<int>(std::ceil(max_tile_y)),
+                             candidates);
+
+    for (size_t i : candidates) {
+        if (i >= entityManager.getEntityCount() || !entityManager.is_alive[i]) {
+            continue;
+        }
+        float entity_x = static_cast<float>(entityManager.x[i]);
+        float entity_y = static_cast<float>(entityManager.y[i]);
+        if (entity_x >= min_tile_x && entity_x <= max_tile_x && entity_y >= min_tile_y && entity_y <= max_tile_y) {
+            selected.push_back(i);
+        }
+    }
+
+    std::sort(selected.begin(), selected.end());
+    return selected;
+}
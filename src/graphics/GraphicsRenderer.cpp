@@ -4,6 +4,7 @@
 #include "resources/Terrain.h"
 #include "core/EntityManager.h"
 #include "resources/Biome.h"
+#include "common/AnimalConfig.h"
 #include <iostream>
 #include <algorithm>
 #include <cmath>
@@ -27,7 +28,19 @@ const std::string OMNIVORE_TEXTURE_PATH = ASSETS_PATH + "textures/omnivore.png";
 // Backround music file path
 const std::string BACKGROUND_MUSIC_PATH = ASSETS_PATH + "audio/background_music.mp3";
 
-GraphicsRenderer::GraphicsRenderer() : m_window(), m_tile_size(0) {}
+// --- Level of Detail ---
+// Below this many screen pixels per tile, animal sprites are sub-pixel noise and the
+// population is drawn as a per-cell density heatmap instead.
+const float LOD_MIN_TILE_SCREEN_PIXELS = 4.0f;
+// Entities per tile at which a heatmap cell reaches full opacity
+const float HEATMAP_FULL_DENSITY = 0.25f;
+const sf::Uint8 HEATMAP_MAX_ALPHA = 200;
+// Species colours blended per cell, weighted by population
+const sf::Color HEATMAP_HERBIVORE_COLOR(80, 220, 80);
+const sf::Color HEATMAP_CARNIVORE_COLOR(230, 50, 50);
+const sf::Color HEATMAP_OMNIVORE_COLOR(70, 130, 255);
+
+GraphicsRenderer::GraphicsRenderer() : m_window(), m_tile_size(0), m_heatmap_turn(-1) {}
 
 GraphicsRenderer::~GraphicsRenderer() {}
 
@@ -94,14 +107,14 @@ bool GraphicsRenderer::isOpen() const {
     return m_window.isOpen();
 }
 
-void GraphicsRenderer::handleEvents(const EntityManager* entityManager) {
+void GraphicsRenderer::handleEvents(const World* world) {
     sf::Event event;
     while (m_window.pollEvent(event)) {
         if (event.type == sf::Event::Closed || (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape)) {
             m_window.close();
         }
         
-        m_camera->handleEvent(event, m_window, entityManager);
+        m_camera->handleEvent(event, m_window, world);
     }
 }
 
@@ -114,6 +127,7 @@ void GraphicsRenderer::display() {
 }
 
 void GraphicsRenderer::update(float delta_time, const EntityManager* entityManager) {
+    m_camera->refreshSelection(entityManager);
     m_camera->updateFollowMode(entityManager);
     m_camera->update(delta_time);
 }
@@ -133,7 +147,7 @@ void GraphicsRenderer::drawWorld(const World& world) {
     // Only iterate through visible tiles
     for (int y = start_y; y <= end_y; ++y) {
         for (int x = start_x; x <= end_x; ++x) {
-            const Tile& tile = world.getTile(x, y);
+            const Tile tile = world.getTile(x, y);
 
             // 1. Draw the terrain texture as the base
             sf::Sprite terrain_sprite;
@@ -171,17 +185,36 @@ void GraphicsRenderer::drawWorld(const World& world) {
     }
 }
 
-void GraphicsRenderer::drawEntities(const EntityManager& entityManager, float animation_progress) {
+void GraphicsRenderer::drawEntities(const World& world, float animation_progress) {
     m_window.setView(m_camera->getView());
+    const EntityManager& entityManager = world.getEntityManager();
+
+    // Zoomed far out: draw the aggregated density grid instead of individual sprites
+    if (isHeatmapLODActive()) {
+        drawPopulationHeatmap(world);
+        return;
+    }
 
     // View frustum culling - only render entities in visible area
     sf::FloatRect visible_bounds = getVisibleBounds();
 
+    // Query the spatial grid for the cells overlapping the view instead of scanning every entity.
+    // The grid is keyed by current positions, but sprites are drawn at interpolated positions,
+    // so pad the tile range by one full move step to catch entities walking into view.
+    int pad = MAX_MOVE_STEPS_PER_TURN + 1;
+    int start_x = static_cast<int>(std::floor(visible_bounds.left / m_tile_size)) - pad;
+    int end_x = static_cast<int>((visible_bounds.left + visible_bounds.width) / m_tile_size) + pad;
+    int start_y = static_cast<int>(std::floor(visible_bounds.top / m_tile_size)) - pad;
+    int end_y = static_cast<int>((visible_bounds.top + visible_bounds.height) / m_tile_size) + pad;
+
+    m_visible_entities.clear();
+    world.getEntitiesInArea(start_x, start_y, end_x, end_y, m_visible_entities);
+
     // Easing function for smooth animation
     float eased_progress = 1.0f - (1.0f - animation_progress) * (1.0f - animation_progress);
 
-    for (size_t i = 0; i < entityManager.getEntityCount(); ++i) {
-        if (!entityManager.is_alive[i]) {
+    for (size_t i : m_visible_entities) {
+        if (i >= entityManager.getEntityCount() || !entityManager.is_alive[i]) {
             continue;
         }
 
@@ -216,6 +249,63 @@ void GraphicsRenderer::drawEntities(const EntityManager& entityManager, float an
     }
 }
 
+bool GraphicsRenderer::isHeatmapLODActive() const {
+    return m_tile_size / m_camera->getZoomLevel() < LOD_MIN_TILE_SCREEN_PIXELS;
+}
+
+void GraphicsRenderer::drawPopulationHeatmap(const World& world) {
+    int grid_width = world.getSpatialGridWidth();
+    int grid_height = world.getSpatialGridHeight();
+    int cell_size = world.getSpatialGridCellSize();
+
+    // The spatial grid only changes once per turn, so only rebuild the texture then.
+    // Cost is proportional to the number of grid cells, independent of population.
+    if (m_heatmap_turn != world.getTurnCount()) {
+        if (m_heatmap_pixels.size() != static_cast<size_t>(grid_width * grid_height * 4)) {
+            m_heatmap_pixels.assign(grid_width * grid_height * 4, 0);
+            m_heatmap_texture.create(grid_width, grid_height);
+            m_heatmap_texture.setSmooth(true); // Bilinear filtering blends neighbouring cells
+        }
+
+        float full_density_count = HEATMAP_FULL_DENSITY * cell_size * cell_size;
+
+        for (int cy = 0; cy < grid_height; ++cy) {
+            for (int cx = 0; cx < grid_width; ++cx) {
+                int herbivores = world.getSpatialCellPopulation(cx, cy, AnimalType::HERBIVORE);
+                int carnivores = world.getSpatialCellPopulation(cx, cy, AnimalType::CARNIVORE);
+                int omnivores = world.getSpatialCellPopulation(cx, cy, AnimalType::OMNIVORE);
+                int total = herbivores + carnivores + omnivores;
+
+                sf::Uint8* pixel = &m_heatmap_pixels[(cy * grid_width + cx) * 4];
+                if (total == 0) {
+                    pixel[0] = pixel[1] = pixel[2] = pixel[3] = 0;
+                    continue;
+                }
+
+                // Blend species colours by their share of the cell population
+                float inv_total = 1.0f / total;
+                float wh = herbivores * inv_total, wc = carnivores * inv_total, wo = omnivores * inv_total;
+                pixel[0] = static_cast<sf::Uint8>(HEATMAP_HERBIVORE_COLOR.r * wh + HEATMAP_CARNIVORE_COLOR.r * wc + HEATMAP_OMNIVORE_COLOR.r * wo);
+                pixel[1] = static_cast<sf::Uint8>(HEATMAP_HERBIVORE_COLOR.g * wh + HEATMAP_CARNIVORE_COLOR.g * wc + HEATMAP_OMNIVORE_COLOR.g * wo);
+                pixel[2] = static_cast<sf::Uint8>(HEATMAP_HERBIVORE_COLOR.b * wh + HEATMAP_CARNIVORE_COLOR.b * wc + HEATMAP_OMNIVORE_COLOR.b * wo);
+
+                // Opacity scales with density, so sparse cells stay faint over the terrain
+                float density = std::min(1.0f, total / full_density_count);
+                pixel[3] = static_cast<sf::Uint8>(HEATMAP_MAX_ALPHA * (0.25f + 0.75f * density));
+            }
+        }
+
+        m_heatmap_texture.update(m_heatmap_pixels.data());
+        m_heatmap_turn = world.getTurnCount();
+    }
+
+    // One sprite covers the whole map: each texel stretches over one spatial grid cell
+    sf::Sprite heatmap_sprite(m_heatmap_texture);
+    float texel_pixels = static_cast<float>(cell_size * m_tile_size);
+    heatmap_sprite.setScale(texel_pixels, texel_pixels);
+    m_window.draw(heatmap_sprite, sf::BlendAlpha);
+}
+
 void GraphicsRenderer::drawUI(const World& world, bool is_paused) {
     m_ui_manager->drawUI(m_window, world, is_paused);
 }
@@ -229,6 +319,11 @@ void GraphicsRenderer::drawCursor() {
 }
 
 void GraphicsRenderer::drawSelectionIndicator(const EntityManager& entityManager, float animation_progress) {
+    if (m_camera->isBoxSelecting() || !m_camera->getBoxSelection().empty()) {
+        m_window.setView(m_camera->getView());
+        drawBoxSelection(entityManager, 1.0f - (1.0f - animation_progress) * (1.0f - animation_progress));
+    }
+
     if (!m_camera->hasSelectedEntity()) {
         return;
     }
@@ -286,8 +381,39 @@ void GraphicsRenderer::drawSelectionIndicator(const EntityManager& entityManager
     m_window.draw(inner_circle);
 }
 
-void GraphicsRenderer::drawEntityDetailPanel(const EntityManager& entityManager) {
-    m_ui_manager->drawEntityDetailPanel(m_window, entityManager, *m_camera);
+void GraphicsRenderer::drawBoxSelection(const EntityManager& entityManager, float eased_progress) {
+    // Rectangle being dragged
+    if (m_camera->isBoxSelecting()) {
+        sf::FloatRect rect = m_camera->getBoxSelectionRect();
+        sf::RectangleShape box(sf::Vector2f(rect.width, rect.height));
+        box.setPosition(rect.left, rect.top);
+        box.setFillColor(sf::Color(255, 255, 0, 40));
+        box.setOutlineColor(sf::Color(255, 255, 0, 200));
+        box.setOutlineThickness(2.0f * m_camera->getZoomLevel()); // Constant on-screen thickness
+        m_window.draw(box);
+    }
+
+    // Outline every box-selected entity that is still alive
+    sf::RectangleShape marker(sf::Vector2f(static_cast<float>(m_tile_size), static_cast<float>(m_tile_size)));
+    marker.setFillColor(sf::Color::Transparent);
+    marker.setOutlineColor(sf::Color(255, 255, 0, 180));
+    marker.setOutlineThickness(1.5f);
+
+    for (size_t id : m_camera->getBoxSelection()) {
+        if (id >= entityManager.getEntityCount() || !entityManager.is_alive[id]) {
+            continue;
+        }
+        float prev_pixel_x = entityManager.prev_x[id] * m_tile_size;
+        float prev_pixel_y = entityManager.prev_y[id] * m_tile_size;
+        float interp_x = prev_pixel_x + (entityManager.x[id] * m_tile_size - prev_pixel_x) * eased_progress;
+        float interp_y = prev_pixel_y + (entityManager.y[id] * m_tile_size - prev_pixel_y) * eased_progress;
+        marker.setPosition(interp_x, interp_y);
+        m_window.draw(marker);
+    }
+}
+
+void GraphicsRenderer::drawEntityDetailPanel(const World& world) {
+    m_ui_manager->drawEntityDetailPanel(m_window, world, *m_camera);
 }
 
 sf::FloatRect GraphicsRenderer::getVisibleBounds() const {
@@ -10,7 +10,15 @@ const std::string HERBIVORE_TEXTURE_PATH_UI = ASSETS_PATH_UI + "textures/herbivo
 const std::string CARNIVORE_TEXTURE_PATH_UI = ASSETS_PATH_UI + "textures/carnivore.png";
 const std::string OMNIVORE_TEXTURE_PATH_UI = ASSETS_PATH_UI + "textures/omnivore.png";
 
-UIManager::UIManager() : m_last_selected_entity(static_cast<size_t>(-1)) {}
+// Entity detail panel layout
+const float DETAIL_PANEL_WIDTH = 450.0f;
+const float DETAIL_PANEL_HEIGHT = 750.0f;
+const float DETAIL_PANEL_RIGHT_MARGIN = 100.0f;
+const float DETAIL_PANEL_TOP = 20.0f;
+const float DETAIL_PANEL_OUTLINE = 2.0f;
+
+UIManager::UIManager()
+    : m_panel_texture_ready(false), m_last_selected_entity(static_cast<size_t>(-1)), m_last_panel_turn(-1) {}
 
 bool UIManager::loadAssets() {
     if (!m_font.loadFromFile(FONT_PATH_UI)) {
@@ -49,10 +57,11 @@ void UIManager::drawUI(sf::RenderWindow& window, const World& world, bool is_pau
         return;
     }
 
+    // Population counts are maintained incrementally by the EntityManager
     const EntityManager& data = world.getEntityManager();
-    size_t num_entities = data.getEntityCount();
-    int herbivore_count = 0; int carnivore_count = 0; int omnivore_count = 0;
-    for (size_t i = 0; i < num_entities; ++i) { if (data.is_alive[i]) { switch (data.type[i]) { case AnimalType::HERBIVORE: herbivore_count++; break; case AnimalType::CARNIVORE: carnivore_count++; break; case AnimalType::OMNIVORE:  omnivore_count++; break; default: break; } } }
+    int herbivore_count = data.getAliveCount(AnimalType::HERBIVORE);
+    int carnivore_count = data.getAliveCount(AnimalType::CARNIVORE);
+    int omnivore_count = data.getAliveCount(AnimalType::OMNIVORE);
 
     int total_living_entities = herbivore_count + carnivore_count + omnivore_count;
 
@@ -180,11 +189,12 @@ void UIManager::drawCursor(sf::RenderWindow& window) {
     window.draw(m_cursor_sprite);
 }
 
-void UIManager::drawEntityDetailPanel(sf::RenderWindow& window, const EntityManager& entityManager, const Camera& camera) {
+void UIManager::drawEntityDetailPanel(sf::RenderWindow& window, const World& world, const Camera& camera) {
     if (!camera.hasSelectedEntity()) {
         return;
     }
     
+    const EntityManager& entityManager = world.getEntityManager();
     size_t selected_id = camera.getSelectedEntity();
     
     // Validate entity exists
@@ -192,15 +202,47 @@ void UIManager::drawEntityDetailPanel(sf::RenderWindow& window, const EntityMana
         return;
     }
     
+    // The texture includes the outline, which is drawn outside the panel rectangle
+    if (!m_panel_texture_ready) {
+        unsigned int texture_width = static_cast<unsigned int>(DETAIL_PANEL_WIDTH + 2 * DETAIL_PANEL_OUTLINE);
+        unsigned int texture_height = static_cast<unsigned int>(DETAIL_PANEL_HEIGHT + 2 * DETAIL_PANEL_OUTLINE);
+        if (!m_panel_texture.create(texture_width, texture_height)) {
+            std::cerr << "Error creating entity detail panel texture." << std::endl;
+            return;
+        }
+        m_panel_texture_ready = true;
+        m_last_selected_entity = static_cast<size_t>(-1); // Force a rebuild
+    }
+    
+    // Displayed values only change when the simulation advances, so re-layout the text
+    // at most once per turn (or when a different entity is selected)
+    if (selected_id != m_last_selected_entity || world.getTurnCount() != m_last_panel_turn) {
+        renderEntityDetailPanel(entityManager, selected_id);
+        m_last_selected_entity = selected_id;
+        m_last_panel_turn = world.getTurnCount();
+    }
+    
     // Set UI view
     sf::View ui_view(sf::FloatRect(0, 0, window.getSize().x, window.getSize().y));
     window.setView(ui_view);
     
-    // Panel dimensions and position (right side of screen, moved left)
-    float panel_width = 450.0f;  // Increased width
-    float panel_height = 750.0f; // Extended height for more spacing
-    float panel_x = window.getSize().x - panel_width - 100.0f; // Moved further left (was 20.0f)
-    float panel_y = 20.0f;
+    // Panel position (right side of screen, moved left)
+    float panel_x = window.getSize().x - DETAIL_PANEL_WIDTH - DETAIL_PANEL_RIGHT_MARGIN;
+    float panel_y = DETAIL_PANEL_TOP;
+    
+    sf::Sprite panel_sprite(m_panel_texture.getTexture());
+    panel_sprite.setPosition(panel_x - DETAIL_PANEL_OUTLINE, panel_y - DETAIL_PANEL_OUTLINE);
+    window.draw(panel_sprite);
+}
+
+void UIManager::renderEntityDetailPanel(const EntityManager& entityManager, size_t selected_id) {
+    m_panel_texture.clear(sf::Color::Transparent);
+    
+    // Panel coordinates are local to the texture, inset by the outline thickness
+    float panel_width = DETAIL_PANEL_WIDTH;
+    float panel_height = DETAIL_PANEL_HEIGHT;
+    float panel_x = DETAIL_PANEL_OUTLINE;
+    float panel_y = DETAIL_PANEL_OUTLINE;
     
     // Draw semi-transparent background panel
     sf::RectangleShape panel_bg;
@@ -208,8 +250,8 @@ void UIManager::drawEntityDetailPanel(sf::RenderWindow& window, const EntityMana
     panel_bg.setPosition(panel_x, panel_y);
     panel_bg.setFillColor(sf::Color(0, 0, 0, 180)); // Semi-transparent black
     panel_bg.setOutlineColor(sf::Color(100, 100, 100, 200));
-    panel_bg.setOutlineThickness(2.0f);
-    window.draw(panel_bg);
+    panel_bg.setOutlineThickness(DETAIL_PANEL_OUTLINE);
+    m_panel_texture.draw(panel_bg);
     
     // Title
     sf::Text title_text;
@@ -218,7 +260,7 @@ void UIManager::drawEntityDetailPanel(sf::RenderWindow& window, const EntityMana
     title_text.setCharacterSize(24); // Larger title
     title_text.setFillColor(sf::Color::White);
     title_text.setPosition(panel_x + 15, panel_y + 15);
-    window.draw(title_text);
+    m_panel_texture.draw(title_text);
     
     // Entity information
     float text_y = panel_y + 50; // Adjusted for removed instruction text
@@ -233,7 +275,7 @@ void UIManager::drawEntityDetailPanel(sf::RenderWindow& window, const EntityMana
         info_text.setCharacterSize(16); // Larger text
         info_text.setFillColor(color);
         info_text.setPosition(panel_x + 15, text_y);
-        window.draw(info_text);
+        m_panel_texture.draw(info_text);
         text_y += line_spacing;
     };
     
@@ -246,7 +288,7 @@ void UIManager::drawEntityDetailPanel(sf::RenderWindow& window, const EntityMana
         header_text.setCharacterSize(18);
         header_text.setFillColor(sf::Color(200, 200, 100)); // Light yellow
         header_text.setPosition(panel_x + 15, text_y);
-        window.draw(header_text);
+        m_panel_texture.draw(header_text);
         text_y += line_spacing;
     };
     
@@ -298,6 +340,8 @@ void UIManager::drawEntityDetailPanel(sf::RenderWindow& window, const EntityMana
             drawInfoLine("Family", "No parent tracked");
         }
     }
+    
+    m_panel_texture.display();
 }
 
 std::string UIManager::getAnimalTypeString(AnimalType type) {
@@ -317,6 +361,7 @@ std::string UIManager::getAIStateString(AIState state) {
         case AIState::CHASING: return "Chasing";
         case AIState::HERDING: return "Herding";
         case AIState::PACK_HUNTING: return "Pack Hunting";
+        case AIState::TRACKING: return "Tracking";
         default: return "Unknown";
     }
 }
@@ -9,11 +9,21 @@
 #include <string> // Needed for window title
 #include <SFML/System.hpp> // Needed for sf::Clock and sf::Time
 
+// Prints how evenly a cost-scheduled system loop kept the threads busy over the run
+static void printThreadLoad(const std::string& name, const LoopThreadStats& stats) {
+    std::cout << name << " threads: busy " << stats.getTotalBusyMs() << " ms, idle "
+              << stats.getTotalIdleMs() << " ms (" << stats.getIdleFraction() * 100.0 << "% idle)" << std::endl;
+}
+
 int main() {
     // ... (simulation parameters) ...
     const int WORLD_WIDTH = 240;
     const int WORLD_HEIGHT = 135; 
     const int SPATIAL_GRID_CELL_SIZE = 0; // 0 = auto-calculate optimal size
+    const WorldGeneratorType WORLD_GENERATOR = WorldGeneratorType::REGION_WFC; // or NOISE_FIELD
+    const uint64_t WORLD_SEED = 0;          // 0 = new random world every run
+    const std::string WORLD_CACHE_DIR = ""; // e.g. "world_cache" (must exist) to reuse generated worlds
+    const int AI_DECISION_BUDGET = 0;       // Max AI decisions per turn, 0 = unlimited
     const int INITIAL_HERBIVORES = 250;
     const int INITIAL_OMNIVORES = 50;
     const int INITIAL_CARNIVORES = 50;
@@ -29,6 +39,12 @@ int main() {
 
     // --- Simulation Setup ---
     World world(WORLD_WIDTH, WORLD_HEIGHT, SPATIAL_GRID_CELL_SIZE);
+    world.setGeneratorType(WORLD_GENERATOR);
+    if (WORLD_SEED != 0) {
+        world.setGenerationSeed(WORLD_SEED);
+    }
+    world.setWorldCacheDirectory(WORLD_CACHE_DIR);
+    world.setAIDecisionBudget(AI_DECISION_BUDGET);
     world.init(INITIAL_HERBIVORES, INITIAL_CARNIVORES, INITIAL_OMNIVORES);
 
     // --- Graphics Setup ---
@@ -54,7 +70,7 @@ int main() {
     // --- Main SFML Window Loop ---
     while (renderer.isOpen()) {
         // Handle window events (closing)
-        renderer.handleEvents(&world.getEntityManager());
+        renderer.handleEvents(&world);
 
         // --- Handle Pause Input ---
         bool is_p_currently_pressed = sf::Keyboard::isKeyPressed(sf::Keyboard::P);
@@ -101,10 +117,10 @@ int main() {
         renderer.clear(sf::Color(100, 149, 237)); // Cornflower Blue
 
         renderer.drawWorld(world);
-        renderer.drawEntities(world.getEntityManager(), animation_progress);
+        renderer.drawEntities(world, animation_progress);
         renderer.drawSelectionIndicator(world.getEntityManager(), animation_progress);
         renderer.drawUI(world, is_paused);
-        renderer.drawEntityDetailPanel(world.getEntityManager());
+        renderer.drawEntityDetailPanel(world);
 
         // Draw simulation ended message if simulation has ended
         if (simulation_ended) {
@@ -118,6 +134,8 @@ int main() {
     } // End while (renderer.isOpen())
 
     std::cout << "SFML Window closed. Exiting simulation." << std::endl;
+    printThreadLoad("AI", world.getAIThreadStats());
+    printThreadLoad("Metabolism", world.getMetabolismThreadStats());
 
     return 0;
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 // Water: Consists of only water terrain, no resources
 const BiomeType BIOME_WATER = {
     "Water", // name
+    BIOME_ID_WATER, // id
     {        // terrain_distribution
         {&TERRAIN_WATER, 1.0f} // 100% water terrain
     },
@@ -17,6 +18,7 @@ const BiomeType BIOME_WATER = {
 // Barren: Mostly empty normal terrain, some grass
 const BiomeType BIOME_BARREN = {
     "Barren", // name
+    BIOME_ID_BARREN, // id
     {         // terrain_distribution
         {&TERRAIN_NORMAL, 1.0f} // 100% normal terrain
     },
@@ -29,6 +31,7 @@ const BiomeType BIOME_BARREN = {
 // Rocky: Only rock terrain, no resources
 const BiomeType BIOME_ROCKY = {
     "Rocky", // name
+    BIOME_ID_ROCKY, // id
     {        // terrain_distribution
         {&TERRAIN_ROCKY, 1.0f} // 100% rocky terrain
     },
@@ -40,6 +43,7 @@ const BiomeType BIOME_ROCKY = {
 // Grassland: Normal terrain with grass, some bushes, rarely berries
 const BiomeType BIOME_GRASSLAND = {
     "Grassland", // name
+    BIOME_ID_GRASSLAND, // id
     {            // terrain_distribution
         {&TERRAIN_NORMAL, 1.0f} // 100% normal terrain
     },
@@ -54,6 +58,7 @@ const BiomeType BIOME_GRASSLAND = {
 // Forest: Normal terrain with mostly bushes, some grass, few berries (hinders sight)
 const BiomeType BIOME_FOREST = {
     "Forest", // name
+    BIOME_ID_FOREST, // id
     {         // terrain_distribution
         {&TERRAIN_NORMAL, 1.0f} // 100% normal terrain (sight modifier applied in systems)
     },
@@ -68,6 +73,7 @@ const BiomeType BIOME_FOREST = {
 // Fertile: Normal terrain with mainly berries, some bush and grass
 const BiomeType BIOME_FERTILE = {
     "Fertile", // name
+    BIOME_ID_FERTILE, // id
     {          // terrain_distribution
         {&TERRAIN_NORMAL, 1.0f} // 100% normal terrain
     },
@@ -78,3 +84,12 @@ const BiomeType BIOME_FERTILE = {
     },
     sf::Color(255, 215, 0) // Golden fertile color
 };
+
+const BiomeType* const ALL_BIOMES[BIOME_ID_COUNT] = {
+    &BIOME_WATER,
+    &BIOME_BARREN,
+    &BIOME_ROCKY,
+    &BIOME_GRASSLAND,
+    &BIOME_FOREST,
+    &BIOME_FERTILE
+};
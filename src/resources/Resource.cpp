@@ -2,6 +2,7 @@
 
 const ResourceType RESOURCE_GRASS = {
     "Grass",
+    RESOURCE_ID_GRASS, // Id
     10.0f, // Max amount
     1.0f, // Regrowth rate per turn
     1.0f, // Nutritional value
@@ -10,6 +11,7 @@ const ResourceType RESOURCE_GRASS = {
 
 const ResourceType RESOURCE_BERRIES = {
     "Berries",
+    RESOURCE_ID_BERRIES, // Id
     5.0f, // Max amount
     0.5f, // Regrowth rate per turn
     3.0f, // Nutritional value
@@ -18,8 +20,16 @@ const ResourceType RESOURCE_BERRIES = {
 
 const ResourceType RESOURCE_BUSH = {
     "Bush",
+    RESOURCE_ID_BUSH, // Id
     7.0f, // Max amount (between grass and berries)
     0.75f, // Regrowth rate per turn (between grass and berries)
     2.0f, // Nutritional value (between grass and berries)
     'B' // Symbol to draw on the grid
-};
\ No newline at end of file
+};
+
+const ResourceType* const ALL_RESOURCES[RESOURCE_ID_COUNT] = {
+    nullptr, // RESOURCE_ID_NONE
+    &RESOURCE_GRASS,
+    &RESOURCE_BERRIES,
+    &RESOURCE_BUSH
+};
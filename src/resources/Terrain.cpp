@@ -3,6 +3,7 @@
 // Normal terrain - no restrictions or modifiers
 const TerrainType TERRAIN_NORMAL = {
     "Normal",
+    TERRAIN_ID_NORMAL, // Id
     1.0f,        // Normal speed
     1.0f,        // Normal sight
     {},          // All animal types allowed (empty set)
@@ -13,6 +14,7 @@ const TerrainType TERRAIN_NORMAL = {
 // Water terrain - slows down all entities
 const TerrainType TERRAIN_WATER = {
     "Water",
+    TERRAIN_ID_WATER, // Id
     0.5f,        // Half speed
     1.0f,        // Normal sight
     {},          // All animal types allowed
@@ -23,9 +25,16 @@ const TerrainType TERRAIN_WATER = {
 // Rocky terrain - only carnivores and herbivores can traverse
 const TerrainType TERRAIN_ROCKY = {
     "Rocky",
+    TERRAIN_ID_ROCKY, // Id
     1.0f,        // Normal speed
     1.0f,        // Normal sight
     {AnimalType::CARNIVORE, AnimalType::HERBIVORE}, // Only carnivores and herbivores
     '^',         // Mountain/rock symbol
     sf::Color(120, 120, 120) // Gray rock color
 };
+
+const TerrainType* const ALL_TERRAINS[TERRAIN_ID_COUNT] = {
+    &TERRAIN_NORMAL,
+    &TERRAIN_WATER,
+    &TERRAIN_ROCKY
+};
@@ -1,327 +1,615 @@
 #include "systems/AISystem.h"
 #include "common/AnimalConfig.h"
 #include "common/AnimalTypes.h"
+#include "common/SpeciesTraits.h"
+#include "core/DiscOffsets.h"
 #include <algorithm>
 #include <cmath>
 
 namespace AISystem {
 
-    void run(EntityManager& data, const World& world) {
-        size_t num_entities = data.getEntityCount();
+    namespace {
+        // Exact neighbour query, skipped in O(1) when the influence fields show fewer than
+        // min_count animals of the type can be in range (the result would then be unused).
+        // The ids live in the thread's arena, which is rewound after each entity's decision.
+        ScratchSpan<size_t> senseAnimals(const EntityManager& data, const World& world, ScratchArena& arena, size_t entity_id, int radius, AnimalType type, int min_count = 1) {
+            if (!world.mayHaveAnimalsNear(data.x[entity_id], data.y[entity_id], radius, type, min_count)) return {};
+            return world.getAnimalsNear(data, data.x[entity_id], data.y[entity_id], radius, type, arena);
+        }
+    }
+
+    // --- Scent Tracking ---
+    namespace {
+        // Combined scent of the species a hunter preys on
+        float getPreyScent(const World& world, int x, int y, AnimalType hunter) {
+            float scent = world.getScent(x, y, SCENT_HERBIVORE);
+            if (hunter == AnimalType::CARNIVORE) scent += world.getScent(x, y, SCENT_OMNIVORE);
+            return scent;
+        }
 
-        // --- PHASE 1: No longer needed - herd benefits moved to MetabolismSystem ---
+        // Picks a target SCENT_TRACKING_STRIDE tiles along the steepest rising prey scent among the
+        // 8 neighbors. False if the scent here is too faint or no neighbor smells stronger.
+        bool followScent(const World& world, int x, int y, AnimalType hunter, int& out_x, int& out_y) {
+            float best_scent = getPreyScent(world, x, y, hunter);
+            if (best_scent < SCENT_TRACKING_THRESHOLD) return false;
 
-        // --- PHASE 2: AI Decision Making (PARALLELIZED) ---
-        // Each thread processes a chunk of entities.
-        // Reads (world, data.is_alive, data.type, data.x, data.y, etc.) are safe.
-        // Writes (data.state, data.target_id, data.target_x, data.target_y) 
-        // must ONLY be to the current entity 'i'. This is true for the AI logic.
-        #pragma omp parallel for
-        for (size_t i = 0; i < num_entities; ++i) {
-                if (!data.is_alive[i]) continue;
+            int best_dx = 0, best_dy = 0;
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    int check_x = x + dx;
+                    int check_y = y + dy;
+                    if ((dx == 0 && dy == 0) || check_x < 0 || check_x >= world.getWidth() || check_y < 0 || check_y >= world.getHeight()) continue;
 
-                // Clear invalid targets at the start of AI processing
-                if (data.target_id[i] != (size_t)-1) {
-                    if (data.target_id[i] >= data.getEntityCount() || !data.is_alive[data.target_id[i]]) {
-                        data.target_id[i] = (size_t)-1; // Clear invalid target
+                    float scent = getPreyScent(world, check_x, check_y, hunter);
+                    if (scent > best_scent) {
+                        best_scent = scent;
+                        best_dx = dx;
+                        best_dy = dy;
                     }
                 }
+            }
+            if (best_dx == 0 && best_dy == 0) return false;
 
-                data.target_id[i] = (size_t)-1; data.target_x[i] = -1; data.target_y[i] = -1;
-
-                // --- Variables local to the loop iteration ---
-                // Use best_food_energy instead of best_food_amount
-                int food_x = -1;
-                int food_y = -1;
-
-                switch (data.type[i]) {
-                    case AnimalType::HERBIVORE:
-                    {
-                        // Herd size calculation for herding behavior (read-only, safe in parallel)
-                        auto nearby_friends = world.getAnimalsNear(data, data.x[i], data.y[i], HERD_BONUS_RADIUS, AnimalType::HERBIVORE);
-                        int herd_size = nearby_friends.size();
-
-                        // Decision Making
-                        auto predators = world.getAnimalsNear(data, data.x[i], data.y[i], static_cast<int>(data.current_sight_radius[i]), AnimalType::CARNIVORE);
-                        auto omni_predators = world.getAnimalsNear(data, data.x[i], data.y[i], static_cast<int>(data.current_sight_radius[i]), AnimalType::OMNIVORE);
-                        predators.insert(predators.end(), omni_predators.begin(), omni_predators.end());
-                        if (!predators.empty()) {
-                            data.state[i] = AIState::FLEEING; data.target_id[i] = predators[0]; continue;
-                        }
+            out_x = std::max(0, std::min(world.getWidth() - 1, x + best_dx * SCENT_TRACKING_STRIDE));
+            out_y = std::max(0, std::min(world.getHeight() - 1, y + best_dy * SCENT_TRACKING_STRIDE));
+            return true;
+        }
+    }
 
-                        // Seek Food if hungry - Prioritize by ENERGY-TO-DISTANCE RATIO
-                        if (data.energy[i] < data.max_energy[i] * HERBIVORE_FOOD_SEEK_THRESHOLD_PERCENTAGE) {
-                            // Use best_food_efficiency (energy per distance)
-                            float best_food_efficiency = 0.0f; 
-                            food_x = -1; food_y = -1; // Reset for this scan
-                            int scan_radius = static_cast<int>(data.current_sight_radius[i]);
-
-                            for (int dy = -scan_radius; dy <= scan_radius; ++dy) { 
-                                for (int dx = -scan_radius; dx <= scan_radius; ++dx) {
-                                    int check_x = data.x[i] + dx; 
-                                    int check_y = data.y[i] + dy;
-                                    
-                                    // Skip if out of bounds or beyond sight radius
-                                    if (check_x < 0 || check_x >= world.getWidth() || 
-                                        check_y < 0 || check_y >= world.getHeight() || 
-                                        dx * dx + dy * dy > scan_radius * scan_radius) {
-                                        continue;
-                                    }
-                                    
-                                    const Tile& tile = world.getTile(check_x, check_y);
-                                    // Ensure there is actually consumable food
-                                    if (tile.resource_type && tile.getConsumableAmount() > 0.0f) {
-                                        float potential_energy = tile.resource_amount * tile.resource_type->nutritional_value;
-                                        
-                                        // Calculate distance (minimum 1 to avoid division by zero)
-                                        float distance = std::max(1.0f, std::sqrt(float(dx * dx + dy * dy)));
-                                        
-                                        // Calculate efficiency: energy per unit distance
-                                        // Add small bonus for very close food to prefer nearby resources
-                                        float efficiency = potential_energy / distance;
-                                        if (distance <= 2.0f) efficiency *= 1.5f; // 50% bonus for adjacent/very close food
-                                        
-                                        if (efficiency > best_food_efficiency) {
-                                            best_food_efficiency = efficiency;
-                                            food_x = check_x; 
-                                            food_y = check_y;
-                                        }
-                                    }
-                                }
-                            }
-                            
-                            // Only seek food if we found something reasonably efficient
-                            if (best_food_efficiency > 0.0f) {
-                                data.state[i] = AIState::SEEKING_FOOD; 
-                                data.target_x[i] = food_x; 
-                                data.target_y[i] = food_y; 
-                                continue;
-                            }
-                        }
+    // --- Food Search ---
+    namespace {
+        // State of one findBestFood call
+        struct FoodSearch {
+            const World& world;
+            int x, y;
+            int min_x, min_y, max_x, max_y; // Scan square clipped to the map
+            float best_efficiency;
+            int best_x, best_y;
+        };
 
-                        // Seek out a herd if not in one - Uses calculated herd_size
-                        if (herd_size <= 1) {
-                            auto potential_herd = world.getAnimalsNear(data, data.x[i], data.y[i], HERD_DETECTION_RADIUS, AnimalType::HERBIVORE);
-                            if (!potential_herd.empty()) {
-                                size_t closest_herd_member_id = (size_t)-1;
-                                float closest_distance_sq = float(HERD_DETECTION_RADIUS * HERD_DETECTION_RADIUS + 1); // Start with max+1
-                                
-                                for(size_t potential_target_id : potential_herd) {
-                                    if (potential_target_id != i) { // Exclude self
-                                        // Calculate distance to this potential herd member
-                                        int dx = data.x[i] - data.x[potential_target_id];
-                                        int dy = data.y[i] - data.y[potential_target_id];
-                                        float distance_sq = float(dx * dx + dy * dy);
-                                        
-                                        if (distance_sq < closest_distance_sq) {
-                                            closest_distance_sq = distance_sq;
-                                            closest_herd_member_id = potential_target_id;
-                                        }
-                                    }
-                                }
-                                
-                                if (closest_herd_member_id != (size_t)-1) {
-                                    data.state[i] = AIState::HERDING; 
-                                    data.target_id[i] = closest_herd_member_id; 
-                                    continue;
-                                }
-                            }
-                        }
-                        data.state[i] = AIState::WANDERING;
-                    } break;
-
-                    case AnimalType::CARNIVORE:
-                    {
-                        // Priority 1: Flee from Omnivore packs
-                        auto nearby_omnivores_for_pack_check = world.getAnimalsNear(data, data.x[i], data.y[i], static_cast<int>(data.current_sight_radius[i]), AnimalType::OMNIVORE);
-                        if(nearby_omnivores_for_pack_check.size() >= OMNIVORE_PACK_THREAT_SIZE) {
-                            // Choose the closest omnivore as flee target
-                            size_t closest_omnivore_id = (size_t)-1;
-                            float closest_distance_sq = float(data.current_sight_radius[i] * data.current_sight_radius[i] + 1);
-                            
-                            for (size_t potential_omnivore_id : nearby_omnivores_for_pack_check) {
-                                // Calculate distance to this omnivore
-                                int dx = data.x[i] - data.x[potential_omnivore_id];
-                                int dy = data.y[i] - data.y[potential_omnivore_id];
-                                float distance_sq = float(dx * dx + dy * dy);
-                                
-                                if (distance_sq < closest_distance_sq) {
-                                    closest_distance_sq = distance_sq;
-                                    closest_omnivore_id = potential_omnivore_id;
-                                }
-                            }
-                            
-                            if (closest_omnivore_id != (size_t)-1) {
-                                data.state[i] = AIState::FLEEING; 
-                                data.target_id[i] = closest_omnivore_id; 
-                                continue;
-                            }
-                        }
+        // Energy per unit distance (minimum distance 1 to avoid division by zero), with a
+        // bonus for very close food to prefer nearby resources. Never increases with distance,
+        // so it also gives an upper bound for a tile from the most food it could hold.
+        float foodEfficiency(float potential_energy, float distance) {
+            distance = std::max(1.0f, distance);
+            float efficiency = potential_energy / distance;
+            if (distance <= 2.0f) efficiency *= 1.5f; // 50% bonus for adjacent/very close food
+            return efficiency;
+        }
 
-                        // --- NEW Priority 2: Confront Rival Carnivores ---
-                        // Check for *other* carnivores within territorial radius
-                        auto nearby_rival_carnivores = world.getAnimalsNear(data, data.x[i], data.y[i], CARNIVORE_TERRITORIAL_RADIUS, AnimalType::CARNIVORE);
-                        // Find the closest rival (excluding self)
-                        if (!nearby_rival_carnivores.empty()) {
-                            size_t closest_rival_id = (size_t)-1;
-                            float closest_distance_sq = float(CARNIVORE_TERRITORIAL_RADIUS * CARNIVORE_TERRITORIAL_RADIUS + 1); // Start with max+1
-                            
-                            for (size_t potential_rival_id : nearby_rival_carnivores) {
-                                if (potential_rival_id != i) { // Exclude self
-                                    // NEW: Check for family relationships - don't attack parents or young offspring
-                                    bool is_family = false;
-                                    if (data.parent_id[i] == potential_rival_id) {
-                                        // Don't attack my parent
-                                        is_family = true;
-                                    } else if (data.parent_id[potential_rival_id] == i && data.age[potential_rival_id] < CARNIVORE_INDEPENDENCE_AGE) {
-                                        // Don't attack my young offspring
-                                        is_family = true;
-                                    }
-                                    
-                                    if (is_family) continue; // Skip family members
-                                    
-                                    // Calculate distance to this rival
-                                    int dx = data.x[i] - data.x[potential_rival_id];
-                                    int dy = data.y[i] - data.y[potential_rival_id];
-                                    float distance_sq = float(dx * dx + dy * dy);
-                                    
-                                    if (distance_sq < closest_distance_sq) {
-                                        closest_distance_sq = distance_sq;
-                                        closest_rival_id = potential_rival_id;
-                                    }
-                                }
-                            }
+        // Tiles are not visited in row-major order, so equal efficiencies are resolved
+        // explicitly to match a plain row-by-row scan
+        void offerFoodTile(FoodSearch& search, int tile_x, int tile_y, float efficiency) {
+            bool earlier = tile_y < search.best_y || (tile_y == search.best_y && tile_x < search.best_x);
+            if (efficiency > search.best_efficiency || (efficiency == search.best_efficiency && earlier)) {
+                search.best_efficiency = efficiency;
+                search.best_x = tile_x;
+                search.best_y = tile_y;
+            }
+        }
+
+        // Lowest pyramid level (at least 1) whose blocks are at least half as wide as the scan
+        // square, so the square overlaps at most 3x3 of them (a single block once capped at the
+        // top level) and its food is bounded in a few lookups
+        int getRootLevel(const World& world, int radius) {
+            int level = 1;
+            while ((2 << level) < 2 * radius + 1 && level + 1 < world.getFoodPyramidLevelCount()) {
+                ++level;
+            }
+            return level;
+        }
+
+        // Walks the disc outward through the shared offset table. Efficiency can only fall with
+        // distance, so the walk stops once even the most food anywhere in the scan square could
+        // not beat the best tile at the current distance.
+        void walkFoodDisc(FoodSearch& search, int radius) {
+            int level = getRootLevel(search.world, radius);
+            float max_food = 0.0f;
+            for (int block_y = search.min_y >> level; block_y <= search.max_y >> level; ++block_y) {
+                for (int block_x = search.min_x >> level; block_x <= search.max_x >> level; ++block_x) {
+                    max_food = std::max(max_food, search.world.getMaxFoodInBlock(level, block_x, block_y));
+                }
+            }
+            if (max_food <= 0.0f) return;
+
+            const DiscOffset* offsets = DiscOffsets::getOffsets().data();
+            size_t count = DiscOffsets::getCount(radius);
+            int bound_distance_sq = -1;
+            for (size_t k = 0; k < count; ++k) {
+                const DiscOffset& offset = offsets[k];
+                if (offset.distance_sq != bound_distance_sq) {
+                    if (foodEfficiency(max_food, offset.distance) < search.best_efficiency) break;
+                    bound_distance_sq = offset.distance_sq;
+                }
+
+                int tile_x = search.x + offset.dx;
+                int tile_y = search.y + offset.dy;
+                if (tile_x < search.min_x || tile_x > search.max_x || tile_y < search.min_y || tile_y > search.max_y) continue;
+
+                float food = search.world.getMaxFoodInBlock(0, tile_x, tile_y);
+                if (food <= 0.0f) continue;
+                offerFoodTile(search, tile_x, tile_y, foodEfficiency(food, offset.distance));
+            }
+        }
+    }
+
+    bool findBestFood(const World& world, int x, int y, int radius, int& out_x, int& out_y) {
+        if (radius < 0) return false;
+        radius = std::min(radius, DiscOffsets::MAX_RADIUS);
+
+        FoodSearch search = {
+            world, x, y,
+            std::max(0, x - radius), std::max(0, y - radius),
+            std::min(world.getWidth() - 1, x + radius), std::min(world.getHeight() - 1, y + radius),
+            0.0f, -1, -1
+        };
+        if (search.min_x > search.max_x || search.min_y > search.max_y) return false;
+
+        walkFoodDisc(search, radius);
+
+        if (search.best_efficiency <= 0.0f) return false;
+        out_x = search.best_x;
+        out_y = search.best_y;
+        return true;
+    }
+
+    // --- Decision Making ---
+    namespace {
+        void resetDecision(EntityManager& data, size_t i) {
+            data.target_id[i] = (size_t)-1; data.target_x[i] = -1; data.target_y[i] = -1;
+        }
+
+        // Full decision for one entity of the species: picks its state and target from scratch
+        template <AnimalType Type>
+        void decide(EntityManager& data, const World& world, ScratchArena& arena, size_t i);
+
+        template <>
+        void decide<AnimalType::HERBIVORE>(EntityManager& data, const World& world, ScratchArena& arena, size_t i) {
+            resetDecision(data, i);
+            int food_x = -1;
+            int food_y = -1;
+
+            // Herd size calculation for herding behavior (read-only, safe in parallel)
+            auto nearby_friends = senseAnimals(data, world, arena, i, HERD_BONUS_RADIUS, AnimalType::HERBIVORE);
+            int herd_size = nearby_friends.size();
+
+            // Decision Making
+            // Carnivores first, then omnivores: the entity flees from the first predator found
+            auto predators = senseAnimals(data, world, arena, i, static_cast<int>(data.current_sight_radius[i]), AnimalType::CARNIVORE);
+            if (predators.empty()) predators = senseAnimals(data, world, arena, i, static_cast<int>(data.current_sight_radius[i]), AnimalType::OMNIVORE);
+            if (!predators.empty()) {
+                data.state[i] = AIState::FLEEING; data.target_id[i] = predators[0]; return;
+            }
+
+            // Seek Food if hungry - Prioritize by ENERGY-TO-DISTANCE RATIO
+            if (data.energy[i] < data.max_energy[i] * HERBIVORE_FOOD_SEEK_THRESHOLD_PERCENTAGE) {
+                if (findBestFood(world, data.x[i], data.y[i], static_cast<int>(data.current_sight_radius[i]), food_x, food_y)) {
+                    data.state[i] = AIState::SEEKING_FOOD; 
+                    data.target_x[i] = food_x; 
+                    data.target_y[i] = food_y; 
+                    return;
+                }
+            }
+
+            // Seek out a herd if not in one - Uses calculated herd_size
+            if (herd_size <= 1) {
+                auto potential_herd = senseAnimals(data, world, arena, i, HERD_DETECTION_RADIUS, AnimalType::HERBIVORE);
+                if (!potential_herd.empty()) {
+                    size_t closest_herd_member_id = (size_t)-1;
+                    float closest_distance_sq = float(HERD_DETECTION_RADIUS * HERD_DETECTION_RADIUS + 1); // Start with max+1
+                    
+                    for(size_t potential_target_id : potential_herd) {
+                        if (potential_target_id != i) { // Exclude self
+                            // Calculate distance to this potential herd member
+                            int dx = data.x[i] - data.x[potential_target_id];
+                            int dy = data.y[i] - data.y[potential_target_id];
+                            float distance_sq = float(dx * dx + dy * dy);
                             
-                            if (closest_rival_id != (size_t)-1) {
-                                data.state[i] = AIState::CHASING; // Use CHASING state for combat
-                                data.target_id[i] = closest_rival_id;
-                                continue; // Decision made
+                            if (distance_sq < closest_distance_sq) {
+                                closest_distance_sq = distance_sq;
+                                closest_herd_member_id = potential_target_id;
                             }
                         }
+                    }
+                    
+                    if (closest_herd_member_id != (size_t)-1) {
+                        data.state[i] = AIState::HERDING; 
+                        data.target_id[i] = closest_herd_member_id; 
+                        return;
+                    }
+                }
 
-                        // Old Priority 2 becomes NEW Priority 3: Hunt Herbivores
-                        auto nearby_herbivores = world.getAnimalsNear(data, data.x[i], data.y[i], static_cast<int>(data.current_sight_radius[i]), AnimalType::HERBIVORE);
-                        if (!nearby_herbivores.empty()) {
-                            data.state[i] = AIState::CHASING; data.target_id[i] = nearby_herbivores[0]; continue;
+                // No herd in sight: head for the nearest herbivore farther away (the movement
+                // system routes such distant goals around impassable terrain through the cluster graph)
+                if (HERD_JOIN_ENABLED) {
+                    auto distant_herd = senseAnimals(data, world, arena, i, HERD_JOIN_RADIUS, AnimalType::HERBIVORE, 2); // Includes itself
+                    size_t closest_id = (size_t)-1;
+                    int closest_distance_sq = HERD_JOIN_RADIUS * HERD_JOIN_RADIUS + 1;
+                    for (size_t potential_target_id : distant_herd) {
+                        if (potential_target_id == i) continue;
+                        int dx = data.x[i] - data.x[potential_target_id];
+                        int dy = data.y[i] - data.y[potential_target_id];
+                        if (dx * dx + dy * dy < closest_distance_sq) {
+                            closest_distance_sq = dx * dx + dy * dy;
+                            closest_id = potential_target_id;
                         }
+                    }
+                    if (closest_id != (size_t)-1) {
+                        data.state[i] = AIState::HERDING;
+                        data.target_id[i] = closest_id;
+                        return;
+                    }
+                }
+            }
+            data.state[i] = AIState::WANDERING;
+        }
 
-                        // Old Priority 3 becomes NEW Priority 4: Hunt lone or small groups of Omnivores
-                        auto nearby_omnivores_full_sight = world.getAnimalsNear(data, data.x[i], data.y[i], static_cast<int>(data.current_sight_radius[i]), AnimalType::OMNIVORE);
-                        if (!nearby_omnivores_full_sight.empty()) {
-                            data.state[i] = AIState::CHASING; data.target_id[i] = nearby_omnivores_full_sight[0]; continue;
-                        }
+        template <>
+        void decide<AnimalType::CARNIVORE>(EntityManager& data, const World& world, ScratchArena& arena, size_t i) {
+            resetDecision(data, i);
 
-                        // Old Priority 4 becomes NEW Priority 5: If no threats, no prey, no rivals, wander
-                        data.state[i] = AIState::WANDERING;
-                    } break;
-
-                    case AnimalType::OMNIVORE:
-                    {
-                        // Priority 1: Flee from Carnivore groups (using full sight radius)
-                        auto nearby_carnivores_for_pack_check = world.getAnimalsNear(data, data.x[i], data.y[i], static_cast<int>(data.current_sight_radius[i]), AnimalType::CARNIVORE);
-                        if(nearby_carnivores_for_pack_check.size() >= OMNIVORE_PACK_HUNT_SIZE) {
-                            // Choose the closest carnivore as flee target
-                            size_t closest_carnivore_id = (size_t)-1;
-                            float closest_distance_sq = float(data.current_sight_radius[i] * data.current_sight_radius[i] + 1);
-                            
-                            for (size_t potential_carnivore_id : nearby_carnivores_for_pack_check) {
-                                // Calculate distance to this carnivore
-                                int dx = data.x[i] - data.x[potential_carnivore_id];
-                                int dy = data.y[i] - data.y[potential_carnivore_id];
-                                float distance_sq = float(dx * dx + dy * dy);
-                                
-                                if (distance_sq < closest_distance_sq) {
-                                    closest_distance_sq = distance_sq;
-                                    closest_carnivore_id = potential_carnivore_id;
-                                }
-                            }
-                            
-                            if (closest_carnivore_id != (size_t)-1) {
-                                data.state[i] = AIState::FLEEING; 
-                                data.target_id[i] = closest_carnivore_id; 
-                                continue;
-                            }
+            // Priority 1: Flee from Omnivore packs
+            auto nearby_omnivores_for_pack_check = senseAnimals(data, world, arena, i, static_cast<int>(data.current_sight_radius[i]), AnimalType::OMNIVORE, OMNIVORE_PACK_THREAT_SIZE);
+            if(nearby_omnivores_for_pack_check.size() >= OMNIVORE_PACK_THREAT_SIZE) {
+                // Choose the closest omnivore as flee target
+                size_t closest_omnivore_id = (size_t)-1;
+                float closest_distance_sq = float(data.current_sight_radius[i] * data.current_sight_radius[i] + 1);
+                
+                for (size_t potential_omnivore_id : nearby_omnivores_for_pack_check) {
+                    // Calculate distance to this omnivore
+                    int dx = data.x[i] - data.x[potential_omnivore_id];
+                    int dy = data.y[i] - data.y[potential_omnivore_id];
+                    float distance_sq = float(dx * dx + dy * dy);
+                    
+                    if (distance_sq < closest_distance_sq) {
+                        closest_distance_sq = distance_sq;
+                        closest_omnivore_id = potential_omnivore_id;
+                    }
+                }
+                
+                if (closest_omnivore_id != (size_t)-1) {
+                    data.state[i] = AIState::FLEEING; 
+                    data.target_id[i] = closest_omnivore_id; 
+                    return;
+                }
+            }
+
+            // --- NEW Priority 2: Confront Rival Carnivores ---
+            // Check for *other* carnivores within territorial radius
+            auto nearby_rival_carnivores = senseAnimals(data, world, arena, i, CARNIVORE_TERRITORIAL_RADIUS, AnimalType::CARNIVORE);
+            // Find the closest rival (excluding self)
+            if (!nearby_rival_carnivores.empty()) {
+                size_t closest_rival_id = (size_t)-1;
+                float closest_distance_sq = float(CARNIVORE_TERRITORIAL_RADIUS * CARNIVORE_TERRITORIAL_RADIUS + 1); // Start with max+1
+                
+                for (size_t potential_rival_id : nearby_rival_carnivores) {
+                    if (potential_rival_id != i) { // Exclude self
+                        // NEW: Check for family relationships - don't attack parents or young offspring
+                        bool is_family = false;
+                        if (data.parent_id[i] == potential_rival_id) {
+                            // Don't attack my parent
+                            is_family = true;
+                        } else if (data.parent_id[potential_rival_id] == i && data.age[potential_rival_id] < CARNIVORE_INDEPENDENCE_AGE) {
+                            // Don't attack my young offspring
+                            is_family = true;
                         }
                         
-                        // Priority 2: Hunt Herbivores
-                        auto nearby_herbivores = world.getAnimalsNear(data, data.x[i], data.y[i], static_cast<int>(data.current_sight_radius[i]), AnimalType::HERBIVORE);
-                        if (!nearby_herbivores.empty()) {
-                            data.state[i] = AIState::CHASING; data.target_id[i] = nearby_herbivores[0]; continue;
+                        if (is_family) continue; // Skip family members
+                        
+                        // Calculate distance to this rival
+                        int dx = data.x[i] - data.x[potential_rival_id];
+                        int dy = data.y[i] - data.y[potential_rival_id];
+                        float distance_sq = float(dx * dx + dy * dy);
+                        
+                        if (distance_sq < closest_distance_sq) {
+                            closest_distance_sq = distance_sq;
+                            closest_rival_id = potential_rival_id;
                         }
+                    }
+                }
+                
+                if (closest_rival_id != (size_t)-1) {
+                    data.state[i] = AIState::CHASING; // Use CHASING state for combat
+                    data.target_id[i] = closest_rival_id;
+                    return; // Decision made
+                }
+            }
 
-                        // Seek Grass if hungry - Prioritize by ENERGY-TO-DISTANCE RATIO
-                        if (data.energy[i] < data.max_energy[i] * OMNIVORE_FOOD_SEEK_THRESHOLD_PERCENTAGE) {
-                            // Use best_food_efficiency (energy per distance)
-                            float best_food_efficiency = 0.0f; 
-                            food_x = -1; food_y = -1; // Reset for this scan
-                            int scan_radius = static_cast<int>(data.current_sight_radius[i]);
-
-                            for (int dy = -scan_radius; dy <= scan_radius; ++dy) { 
-                                for (int dx = -scan_radius; dx <= scan_radius; ++dx) {
-                                    int check_x = data.x[i] + dx; 
-                                    int check_y = data.y[i] + dy;
-                                    
-                                    // Skip if out of bounds or beyond sight radius
-                                    if (check_x < 0 || check_x >= world.getWidth() || 
-                                        check_y < 0 || check_y >= world.getHeight() || 
-                                        dx * dx + dy * dy > scan_radius * scan_radius) {
-                                        continue;
-                                    }
-                                    
-                                    const Tile& tile = world.getTile(check_x, check_y);
-                                    // Ensure there is actually consumable food
-                                    if (tile.resource_type && tile.getConsumableAmount() > 0.0f) {
-                                        float potential_energy = tile.resource_amount * tile.resource_type->nutritional_value;
-                                        
-                                        // Calculate distance (minimum 1 to avoid division by zero)
-                                        float distance = std::max(1.0f, std::sqrt(float(dx * dx + dy * dy)));
-                                        
-                                        // Calculate efficiency: energy per unit distance
-                                        // Add small bonus for very close food to prefer nearby resources
-                                        float efficiency = potential_energy / distance;
-                                        if (distance <= 2.0f) efficiency *= 1.5f; // 50% bonus for adjacent/very close food
-                                        
-                                        if (efficiency > best_food_efficiency) {
-                                            best_food_efficiency = efficiency;
-                                            food_x = check_x; 
-                                            food_y = check_y;
-                                        }
-                                    }
-                                }
-                            }
-                            
-                            // Only seek food if we found something reasonably efficient
-                            if (best_food_efficiency > 0.0f) {
-                                data.state[i] = AIState::SEEKING_FOOD; 
-                                data.target_x[i] = food_x; 
-                                data.target_y[i] = food_y; 
-                                continue;
-                            }
-                        }
+            // Old Priority 2 becomes NEW Priority 3: Hunt Herbivores
+            auto nearby_herbivores = senseAnimals(data, world, arena, i, static_cast<int>(data.current_sight_radius[i]), AnimalType::HERBIVORE);
+            if (!nearby_herbivores.empty()) {
+                data.state[i] = AIState::CHASING; data.target_id[i] = nearby_herbivores[0]; return;
+            }
 
-                        // Priority 4: Pack hunt Carnivores (if we have enough allies)
-                        auto nearby_carnivores_for_hunt = world.getAnimalsNear(data, data.x[i], data.y[i], static_cast<int>(data.current_sight_radius[i]), AnimalType::CARNIVORE);
-                        if (!nearby_carnivores_for_hunt.empty()) {
-                            size_t potential_carnivore_target_id = nearby_carnivores_for_hunt[0];
-                            // Validate target is alive and within reasonable range
-                            if (potential_carnivore_target_id != (size_t)-1 && 
-                                potential_carnivore_target_id < data.getEntityCount() && 
-                                data.is_alive[potential_carnivore_target_id]) {
-                                
-                                // Check if we have enough allies near OURSELVES (the hunter) for pack hunting
-                                // Use a smaller radius for pack coordination (allies need to be close)
-                                auto allies_near_hunter = world.getAnimalsNear(data, data.x[i], data.y[i], 3, AnimalType::OMNIVORE);
-                                if(allies_near_hunter.size() >= OMNIVORE_PACK_HUNT_SIZE) {
-                                    data.state[i] = AIState::PACK_HUNTING; 
-                                    data.target_id[i] = potential_carnivore_target_id; 
-                                    continue;
-                                }
-                            }
-                        }
-                        data.state[i] = AIState::WANDERING;
-                    } break;
-                    default: data.state[i] = AIState::WANDERING; break;
+            // Old Priority 3 becomes NEW Priority 4: Hunt lone or small groups of Omnivores
+            auto nearby_omnivores_full_sight = senseAnimals(data, world, arena, i, static_cast<int>(data.current_sight_radius[i]), AnimalType::OMNIVORE);
+            if (!nearby_omnivores_full_sight.empty()) {
+                data.state[i] = AIState::CHASING; data.target_id[i] = nearby_omnivores_full_sight[0]; return;
+            }
+
+            // Priority 5: Follow the scent of prey beyond sight
+            int scent_x, scent_y;
+            if (followScent(world, data.x[i], data.y[i], AnimalType::CARNIVORE, scent_x, scent_y)) {
+                data.state[i] = AIState::TRACKING; data.target_x[i] = scent_x; data.target_y[i] = scent_y; return;
+            }
+
+            // Priority 6: If no threats, no prey, no rivals, wander
+            data.state[i] = AIState::WANDERING;
+        }
+
+        template <>
+        void decide<AnimalType::OMNIVORE>(EntityManager& data, const World& world, ScratchArena& arena, size_t i) {
+            resetDecision(data, i);
+            int food_x = -1;
+            int food_y = -1;
+
+            // Priority 1: Flee from Carnivore groups (using full sight radius)
+            auto nearby_carnivores_for_pack_check = senseAnimals(data, world, arena, i, static_cast<int>(data.current_sight_radius[i]), AnimalType::CARNIVORE, OMNIVORE_PACK_HUNT_SIZE);
+            if(nearby_carnivores_for_pack_check.size() >= OMNIVORE_PACK_HUNT_SIZE) {
+                // Choose the closest carnivore as flee target
+                size_t closest_carnivore_id = (size_t)-1;
+                float closest_distance_sq = float(data.current_sight_radius[i] * data.current_sight_radius[i] + 1);
+                
+                for (size_t potential_carnivore_id : nearby_carnivores_for_pack_check) {
+                    // Calculate distance to this carnivore
+                    int dx = data.x[i] - data.x[potential_carnivore_id];
+                    int dy = data.y[i] - data.y[potential_carnivore_id];
+                    float distance_sq = float(dx * dx + dy * dy);
+                    
+                    if (distance_sq < closest_distance_sq) {
+                        closest_distance_sq = distance_sq;
+                        closest_carnivore_id = potential_carnivore_id;
+                    }
+                }
+                
+                if (closest_carnivore_id != (size_t)-1) {
+                    data.state[i] = AIState::FLEEING; 
+                    data.target_id[i] = closest_carnivore_id; 
+                    return;
+                }
+            }
+            
+            // Priority 2: Hunt Herbivores
+            auto nearby_herbivores = senseAnimals(data, world, arena, i, static_cast<int>(data.current_sight_radius[i]), AnimalType::HERBIVORE);
+            if (!nearby_herbivores.empty()) {
+                data.state[i] = AIState::CHASING; data.target_id[i] = nearby_herbivores[0]; return;
+            }
+
+            // Seek Grass if hungry - Prioritize by ENERGY-TO-DISTANCE RATIO
+            if (data.energy[i] < data.max_energy[i] * OMNIVORE_FOOD_SEEK_THRESHOLD_PERCENTAGE) {
+                if (findBestFood(world, data.x[i], data.y[i], static_cast<int>(data.current_sight_radius[i]), food_x, food_y)) {
+                    data.state[i] = AIState::SEEKING_FOOD; 
+                    data.target_x[i] = food_x; 
+                    data.target_y[i] = food_y; 
+                    return;
+                }
+            }
+
+            // Priority 4: Pack hunt Carnivores (if we have enough allies)
+            auto nearby_carnivores_for_hunt = senseAnimals(data, world, arena, i, static_cast<int>(data.current_sight_radius[i]), AnimalType::CARNIVORE);
+            if (!nearby_carnivores_for_hunt.empty()) {
+                size_t potential_carnivore_target_id = nearby_carnivores_for_hunt[0];
+                // Validate target is alive and within reasonable range
+                if (potential_carnivore_target_id != (size_t)-1 && 
+                    potential_carnivore_target_id < data.getEntityCount() && 
+                    data.is_alive[potential_carnivore_target_id]) {
+                    
+                    // Check if we have enough allies near OURSELVES (the hunter) for pack hunting
+                    // Use a smaller radius for pack coordination (allies need to be close)
+                    auto allies_near_hunter = senseAnimals(data, world, arena, i, 3, AnimalType::OMNIVORE, OMNIVORE_PACK_HUNT_SIZE);
+                    if(allies_near_hunter.size() >= OMNIVORE_PACK_HUNT_SIZE) {
+                        data.state[i] = AIState::PACK_HUNTING; 
+                        data.target_id[i] = potential_carnivore_target_id; 
+                        return;
+                    }
                 }
+            }
+
+            // Priority 5: Follow the scent of herbivores beyond sight
+            int scent_x, scent_y;
+            if (followScent(world, data.x[i], data.y[i], AnimalType::OMNIVORE, scent_x, scent_y)) {
+                data.state[i] = AIState::TRACKING; data.target_x[i] = scent_x; data.target_y[i] = scent_y; return;
+            }
+            data.state[i] = AIState::WANDERING;
+        }
+    }
+
+    // --- Level of Detail ---
+    namespace {
+        enum DecisionSchedule : unsigned char {
+            DECISION_SKIP,   // Keeps its previous decision this turn
+            DECISION_URGENT, // Must decide this turn
+            DECISION_DUE     // Could keep its decision, but it is old enough to be re-evaluated
+        };
+
+        // A wandering entity with none of the animals its decision logic reacts to in range would
+        // most likely wander again, so its decision can be kept. Hunger and scent are not checked:
+        // they change slowly and are picked up at the next re-evaluation.
+        template <AnimalType Type>
+        bool isStable(const EntityManager& data, const World& world, ScratchArena& arena, size_t i) {
+            if (data.state[i] != AIState::WANDERING) return false;
+
+            int x = data.x[i];
+            int y = data.y[i];
+            int sight = static_cast<int>(data.current_sight_radius[i]);
+            if constexpr (Type == AnimalType::HERBIVORE) {
+                // No predators, and either in a herd already or with no herd to join. Herds beyond
+                // HERD_DETECTION_RADIUS (with HERD_JOIN_ENABLED) are only looked for at the next re-evaluation.
+                if (world.mayHaveAnimalsNear(x, y, sight, AnimalType::CARNIVORE) || world.mayHaveAnimalsNear(x, y, sight, AnimalType::OMNIVORE)) return false;
+                return !world.mayHaveAnimalsNear(x, y, HERD_DETECTION_RADIUS, AnimalType::HERBIVORE, 2) ||
+                       senseAnimals(data, world, arena, i, HERD_BONUS_RADIUS, AnimalType::HERBIVORE, 2).size() >= 2; // Includes itself
+            } else if constexpr (Type == AnimalType::CARNIVORE) {
+                // No rivals (the carnivore counts itself) and no herbivores or omnivores to flee from or hunt
+                return !world.mayHaveAnimalsNear(x, y, CARNIVORE_TERRITORIAL_RADIUS, AnimalType::CARNIVORE, 2) &&
+                       !world.mayHaveAnimalsNear(x, y, sight, AnimalType::HERBIVORE) &&
+                       !world.mayHaveAnimalsNear(x, y, sight, AnimalType::OMNIVORE);
+            } else {
+                // No prey, and no carnivores to flee from or hunt
+                return !world.mayHaveAnimalsNear(x, y, sight, AnimalType::HERBIVORE) &&
+                       !world.mayHaveAnimalsNear(x, y, sight, AnimalType::CARNIVORE);
+            }
         }
+
+        // Whether the hunger check at the top of the food-seeking branch would pass
+        template <AnimalType Type>
+        bool isHungry(const EntityManager& data, size_t i) {
+            if constexpr (SpeciesTraits<Type>::EATS_PLANTS) {
+                return data.energy[i] < data.max_energy[i] * SpeciesTraits<Type>::FOOD_SEEK_THRESHOLD;
+            } else {
+                return false;
+            }
+        }
+
+        // Largest radius the decision logic of the species queries
+        template <AnimalType Type>
+        int getSensingRadius(const EntityManager& data, size_t i) {
+            return std::max(static_cast<int>(data.current_sight_radius[i]), SpeciesTraits<Type>::MIN_SENSING_RADIUS);
+        }
+
+        // A kept (non-wandering) decision still holds while its target is there, the entity's
+        // hunger agrees with it and no spatial cell in its sensing range has changed since it
+        // was made (entities entering, leaving, being born or dying, or food running out)
+        template <AnimalType Type>
+        bool isDecisionCurrent(const EntityManager& data, const World& world, size_t i) {
+            switch (data.state[i]) {
+                case AIState::TRACKING:
+                    return false; // Scent and the target along it move every turn
+                case AIState::SEEKING_FOOD:
+                    if (world.getResourceAmount(data.target_x[i], data.target_y[i]) <= 0.0f) return false;
+                    break;
+                default: {
+                    size_t target = data.target_id[i];
+                    if (target >= data.getEntityCount() || !data.is_alive[target]) return false;
+                } break;
+            }
+            if (isHungry<Type>(data, i) != (data.state[i] == AIState::SEEKING_FOOD)) return false;
+            return !world.hasAreaChangedSince(data.x[i], data.y[i], getSensingRadius<Type>(data, i), data.last_decision_turn[i]);
+        }
+
+        // Schedules one species range (PARALLELIZED): writes schedule[i] for every entity of the
+        // range and nothing else. No barrier at the end; the caller waits for all species at once.
+        template <AnimalType Type>
+        void scheduleSpecies(const EntityManager& data, const World& world, ScratchArena& arena, int turn, unsigned char* schedule) {
+            size_t end = data.getSpeciesEnd(Type);
+
+            #pragma omp for nowait
+            for (size_t i = data.getSpeciesBegin(Type); i < end; ++i) {
+                schedule[i] = DECISION_SKIP;
+                if (!data.is_alive[i]) continue;
+
+                ScratchArena::Mark mark = arena.getMark();
+                bool can_keep = data.last_decision_turn[i] != NO_DECISION_TURN &&
+                                (data.state[i] == AIState::WANDERING ? isStable<Type>(data, world, arena, i) : isDecisionCurrent<Type>(data, world, i));
+                arena.rewind(mark);
+                if (!can_keep) {
+                    schedule[i] = DECISION_URGENT;
+                } else if (turn - data.last_decision_turn[i] >= AI_STABLE_DECISION_INTERVAL) {
+                    schedule[i] = DECISION_DUE;
+                }
+            }
+        }
+
+        // Rough relative cost of a full decision: the neighbour queries grow with the sight disc,
+        // a hungry plant eater also scans the disc for food, a lone herbivore may run the wide
+        // herd-join query, and fleeing or fighting entities usually stop after the first query
+        template <AnimalType Type>
+        float estimateDecisionCost(const EntityManager& data, const World& world, size_t i) {
+            float sight = data.current_sight_radius[i];
+            if (data.state[i] == AIState::FLEEING || data.state[i] == AIState::CHASING) return 1.0f + sight;
+
+            float cost = 1.0f + sight * sight;
+            if (isHungry<Type>(data, i)) cost += 3.14f * sight * sight;
+            if constexpr (Type == AnimalType::HERBIVORE) {
+                // A lone herbivore looking for a distant herd visits every herbivore in the cells
+                // around it
+                if (HERD_JOIN_ENABLED && !world.mayHaveAnimalsNear(data.x[i], data.y[i], HERD_DETECTION_RADIUS, AnimalType::HERBIVORE, 2)) {
+                    cost += world.countAnimalsInCells(data.x[i], data.y[i], HERD_JOIN_RADIUS, AnimalType::HERBIVORE);
+                }
+            }
+            return cost;
+        }
+
+        // Runs the decisions of one species (PARALLELIZED over cost-balanced chunks). deciding is
+        // sorted, so the species' entities form one contiguous run of it.
+        template <AnimalType Type>
+        void decideSpecies(EntityManager& data, const World& world, WorkerPool& pool, int turn, const size_t* deciding, size_t deciding_count, LoopThreadStats* thread_stats) {
+            size_t first = std::lower_bound(deciding, deciding + deciding_count, data.getSpeciesBegin(Type)) - deciding;
+            size_t last = std::lower_bound(deciding, deciding + deciding_count, data.getSpeciesEnd(Type)) - deciding;
+
+            float* costs = pool.allocateShared<float>(last - first);
+            #pragma omp for
+            for (size_t k = first; k < last; ++k) {
+                costs[k - first] = estimateDecisionCost<Type>(data, world, deciding[k]);
+            }
+
+            CostScheduler::parallelFor(costs, last - first, pool, thread_stats, [&](size_t k) {
+                size_t i = deciding[first + k];
+                ScratchArena& arena = pool.getThreadArena();
+                ScratchArena::Mark mark = arena.getMark();
+                decide<Type>(data, world, arena, i);
+                arena.rewind(mark);
+                data.last_decision_turn[i] = turn;
+            });
+        }
+    }
+
+    void run(EntityManager& data, const World& world, WorkerPool& pool, LoopThreadStats* thread_stats) {
+        size_t num_entities = data.getEntityCount();
+        int turn = world.getTurnCount();
+
+        // Entities are grouped by species (see EntityManager::destroyDeadEntities), so every phase
+        // runs one loop per species range, with the species logic fixed at compile time.
+
+        // --- PHASE 1: Scheduling ---
+        // Urgent entities always decide. Stable wanderers and entities whose decision is still
+        // current keep it until it is AI_STABLE_DECISION_INTERVAL turns old, then are
+        // re-evaluated oldest first while the world's budget lasts.
+        unsigned char* schedule = pool.allocateShared<unsigned char>(num_entities);
+        ScratchArena& arena = pool.getThreadArena();
+        scheduleSpecies<AnimalType::HERBIVORE>(data, world, arena, turn, schedule);
+        scheduleSpecies<AnimalType::CARNIVORE>(data, world, arena, turn, schedule);
+        scheduleSpecies<AnimalType::OMNIVORE>(data, world, arena, turn, schedule);
+        #pragma omp barrier
+
+        size_t* deciding = nullptr;
+        size_t deciding_count = 0;
+        #pragma omp single copyprivate(deciding, deciding_count)
+        {
+            ScratchArena& shared_arena = pool.getSharedArena();
+            size_t* due = shared_arena.allocate<size_t>(num_entities);
+            size_t due_count = 0;
+            deciding = shared_arena.allocate<size_t>(num_entities);
+            for (int t = 0; t < ANIMAL_TYPE_COUNT; ++t) {
+                AnimalType type = static_cast<AnimalType>(t);
+                for (size_t i = data.getSpeciesBegin(type); i < data.getSpeciesEnd(type); ++i) {
+                    if (schedule[i] == DECISION_URGENT) deciding[deciding_count++] = i;
+                    else if (schedule[i] == DECISION_DUE) due[due_count++] = i;
+                }
+            }
+
+            size_t budget = static_cast<size_t>(world.getAIDecisionBudget());
+            if (budget > 0) {
+                size_t remaining = deciding_count < budget ? budget - deciding_count : 0;
+                if (due_count > remaining) {
+                    // Deferred entities get older, so every due entity is served eventually
+                    std::nth_element(due, due + remaining, due + due_count, [&data](size_t a, size_t b) {
+                        if (data.last_decision_turn[a] != data.last_decision_turn[b]) return data.last_decision_turn[a] < data.last_decision_turn[b];
+                        return a < b;
+                    });
+                    due_count = remaining;
+                }
+            }
+            std::copy(due, due + due_count, deciding + deciding_count);
+            deciding_count += due_count;
+            std::sort(deciding, deciding + deciding_count);
+        }
+
+        // --- PHASE 2: AI Decision Making ---
+        // Reads (world, data.is_alive, data.type, data.x, data.y, etc.) are safe.
+        // Writes (data.state, data.target_id, data.target_x, data.target_y, data.last_decision_turn)
+        // must ONLY be to the deciding entity. This is true for the AI logic.
+        decideSpecies<AnimalType::HERBIVORE>(data, world, pool, turn, deciding, deciding_count, thread_stats);
+        decideSpecies<AnimalType::CARNIVORE>(data, world, pool, turn, deciding, deciding_count, thread_stats);
+        decideSpecies<AnimalType::OMNIVORE>(data, world, pool, turn, deciding, deciding_count, thread_stats);
     }
 }
@@ -13,7 +13,7 @@ namespace ActionSystem {
         // Parallelizing this loop with a simple #pragma omp parallel for
         // would introduce race conditions because:
         // 1. Combat modifies data for the TARGET entity (data.health[target_id]), not just the current entity (i).
-        // 2. Resource consumption modifies the shared World::grid data (tile.resource_amount).
+        // 2. Resource consumption modifies the shared World tile data (World::consumeResource).
         // More complex synchronization (atomics, locks) or system restructuring is needed for parallel action resolution.
         // For now, processing actions sequentially is safe.
 
@@ -68,6 +68,7 @@ namespace ActionSystem {
                         // Target is dead or invalid - switch to wandering and clear target
                         data.state[i] = AIState::WANDERING;
                         data.target_id[i] = (size_t)-1;
+                        data.last_decision_turn[i] = NO_DECISION_TURN; // Not a stable wander, decide next turn
                     }
                 }
 
@@ -78,26 +79,28 @@ namespace ActionSystem {
 
                     // Check if the entity is on its target tile
                     if (x == data.target_x[i] && y == data.target_y[i]) {
-                        Tile& tile = world.getTile(x, y);
+                        ResourceId resource_id = world.getResourceId(x, y);
 
-                        if (tile.resource_type && tile.getConsumableAmount() > 0.0f) {
+                        if (resource_id != RESOURCE_ID_NONE && world.getResourceAmount(x, y) > 0.0f) {
                             // Consume a fixed amount per turn, e.g., 1.0f unit of resource
                             float amount_to_consume = 1.0f;
-                            float consumed = tile.consume(amount_to_consume);
-                            data.energy[i] += consumed * tile.resource_type->nutritional_value;
+                            float consumed = world.consumeResource(x, y, amount_to_consume);
+                            data.energy[i] += consumed * ALL_RESOURCES[resource_id]->nutritional_value;
                             data.energy[i] = std::min(data.energy[i], data.max_energy[i]); // Cap energy
 
                             // If food is gone, go back to wandering and clear target
-                            if (tile.getConsumableAmount() <= 0.0f) {
+                            if (world.getResourceAmount(x, y) <= 0.0f) {
                                 data.state[i] = AIState::WANDERING;
                                 data.target_x[i] = -1;
                                 data.target_y[i] = -1;
+                                data.last_decision_turn[i] = NO_DECISION_TURN;
                             }
                         } else {
                             // Reached target but no food available - clear target and wander
                             data.state[i] = AIState::WANDERING;
                             data.target_x[i] = -1;
                             data.target_y[i] = -1;
+                            data.last_decision_turn[i] = NO_DECISION_TURN;
                         }
                     }
                 }
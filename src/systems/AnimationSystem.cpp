@@ -6,7 +6,8 @@ namespace AnimationSystem {
         size_t num_entities = data.getEntityCount();
 
         // This can be parallelized as each operation is independent.
-        #pragma omp parallel for
+        // Shared by the team of the turn's parallel region (see WorkerPool).
+        #pragma omp for
         for (size_t i = 0; i < num_entities; ++i) {
             data.prev_x[i] = data.x[i];
             data.prev_y[i] = data.y[i];
@@ -1,7 +1,10 @@
 #include "systems/MovementSystem.h"
 #include "core/Random.h"
 #include "common/AnimalTypes.h"
+#include "common/AnimalConfig.h"
 #include <random>
+#include <algorithm>
+#include <cstdlib>
 
 namespace MovementSystem {
 
@@ -14,9 +17,19 @@ namespace MovementSystem {
             return; // Already at the target coordinates, no movement needed.
         }
 
+        // Distant targets are approached through region route waypoints; steer_x/y is the
+        // waypoint (or the target itself) and is re-steered whenever a waypoint is reached
+        int steer_x, steer_y;
+        getSteeringGoal(world, data.type[entity_id], data.x[entity_id], data.y[entity_id], target_x_coord, target_y_coord, steer_x, steer_y);
+
+        // Shared flow field for the steering goal's region, if one was prepared this turn
+        const FlowField* flow_field = world.getFlowFields().find(data.type[entity_id], steer_x, steer_y);
+
         for (int i = 0; i < data.current_speed[entity_id]; ++i) {
-            int dx = target_x_coord - data.x[entity_id];
-            int dy = target_y_coord - data.y[entity_id];
+            int start_x = data.x[entity_id];
+            int start_y = data.y[entity_id];
+            int dx = steer_x - start_x;
+            int dy = steer_y - start_y;
 
             int move_dx = 0;
             int move_dy = 0;
@@ -32,8 +45,8 @@ namespace MovementSystem {
             }
             // This allows for simultaneous movement in both x and y (diagonal).
 
-            int new_x = data.x[entity_id] + move_dx;
-            int new_y = data.y[entity_id] + move_dy;
+            int new_x = start_x + move_dx;
+            int new_y = start_y + move_dy;
 
             // Check world boundaries and terrain restrictions
             bool x_valid = (new_x >= 0 && new_x < world.getWidth());
@@ -42,8 +55,7 @@ namespace MovementSystem {
             // Check terrain accessibility if coordinates are valid
             bool terrain_accessible = true;
             if (x_valid && y_valid) {
-                const Tile& target_tile = world.getTile(new_x, new_y);
-                terrain_accessible = target_tile.canMove(data.type[entity_id]);
+                terrain_accessible = world.canMove(new_x, new_y, data.type[entity_id]);
             }
             
             if (x_valid && terrain_accessible) {
@@ -52,9 +64,37 @@ namespace MovementSystem {
             if (y_valid && terrain_accessible) {
                 data.y[entity_id] = new_y;
             }
+
+            // Outside the goal region, the greedy step must bring the entity closer along the
+            // flow field; otherwise (blocked by terrain, or heading into a dead end) step to the
+            // neighbor with the lowest distance instead
+            bool rerouted = false;
+            if (flow_field && !flow_field->isInGoalRegion(start_x, start_y)) {
+                uint16_t current_distance = flow_field->getDistance(start_x, start_y);
+                if (current_distance != FLOW_FIELD_UNREACHABLE &&
+                    flow_field->getDistance(data.x[entity_id], data.y[entity_id]) >= current_distance) {
+                    int best_x = start_x;
+                    int best_y = start_y;
+                    uint16_t best_distance = current_distance;
+                    for (int step_y = -1; step_y <= 1; ++step_y) {
+                        for (int step_x = -1; step_x <= 1; ++step_x) {
+                            // Out-of-window and impassable tiles read as unreachable
+                            uint16_t distance = flow_field->getDistance(start_x + step_x, start_y + step_y);
+                            if (distance < best_distance) {
+                                best_distance = distance;
+                                best_x = start_x + step_x;
+                                best_y = start_y + step_y;
+                            }
+                        }
+                    }
+                    data.x[entity_id] = best_x;
+                    data.y[entity_id] = best_y;
+                    rerouted = best_distance < current_distance;
+                }
+            }
             
             // If we can't move in either direction due to boundaries or terrain, stop trying
-            if ((!x_valid || !terrain_accessible) && (!y_valid || !terrain_accessible)) {
+            if (!rerouted && (!x_valid || !terrain_accessible) && (!y_valid || !terrain_accessible)) {
                 break;
             }
 
@@ -62,6 +102,13 @@ namespace MovementSystem {
             if (data.x[entity_id] == target_x_coord && data.y[entity_id] == target_y_coord) {
                 break; // Stop moving for this turn if target reached
             }
+
+            // A reached waypoint only ends a leg of the route: steer for the next one (or the
+            // target) with the remaining steps
+            if (data.x[entity_id] == steer_x && data.y[entity_id] == steer_y) {
+                getSteeringGoal(world, data.type[entity_id], steer_x, steer_y, target_x_coord, target_y_coord, steer_x, steer_y);
+                flow_field = world.getFlowFields().find(data.type[entity_id], steer_x, steer_y);
+            }
         }
     }
 
@@ -111,8 +158,7 @@ namespace MovementSystem {
             // Check terrain accessibility if coordinates are valid
             bool terrain_accessible = true;
             if (x_valid && y_valid) {
-                const Tile& target_tile = world.getTile(new_x, new_y);
-                terrain_accessible = target_tile.canMove(data.type[entity_id]);
+                terrain_accessible = world.canMove(new_x, new_y, data.type[entity_id]);
             }
             
             if (x_valid && terrain_accessible) {
@@ -137,8 +183,7 @@ namespace MovementSystem {
             if (new_x >= 0 && new_x < world.getWidth() && 
                 new_y >= 0 && new_y < world.getHeight()) {
                 
-                const Tile& target_tile = world.getTile(new_x, new_y);
-                if (target_tile.canMove(data.type[entity_id])) {
+                if (world.canMove(new_x, new_y, data.type[entity_id])) {
                     data.x[entity_id] = new_x;
                     data.y[entity_id] = new_y;
                 }
@@ -146,15 +191,151 @@ namespace MovementSystem {
         }
     }
 
+    bool getFleeGoal(const EntityManager& data, size_t entity_id, const World& world, int threat_x, int threat_y, int& out_x, int& out_y) {
+        int x = data.x[entity_id];
+        int y = data.y[entity_id];
+        int away_x = (x > threat_x) - (x < threat_x);
+        int away_y = (y > threat_y) - (y < threat_y);
+        if (away_x == 0 && away_y == 0) return false;
+
+        // Same first step as moveAwayFrom; only a step into terrain needs a goal
+        int step_x = x + away_x;
+        int step_y = y + away_y;
+        if (step_x < 0 || step_x >= world.getWidth() || step_y < 0 || step_y >= world.getHeight() ||
+            world.canMove(step_x, step_y, data.type[entity_id])) return false;
+
+        // Walk back from the far end of the flee line to the first tile the entity can stand on
+        int goal_x = std::clamp(x + away_x * FLEE_GOAL_DISTANCE, 0, world.getWidth() - 1);
+        int goal_y = std::clamp(y + away_y * FLEE_GOAL_DISTANCE, 0, world.getHeight() - 1);
+        while ((goal_x != x || goal_y != y) && !world.canMove(goal_x, goal_y, data.type[entity_id])) {
+            goal_x -= (goal_x > x) - (goal_x < x);
+            goal_y -= (goal_y > y) - (goal_y < y);
+        }
+        if (std::max(std::abs(goal_x - x), std::abs(goal_y - y)) <= 1) return false; // Only the blocked step itself
+
+        out_x = goal_x;
+        out_y = goal_y;
+        return true;
+    }
+
+    bool getMoveGoal(const EntityManager& data, size_t entity_id, const World& world, int& out_x, int& out_y) {
+        switch (data.state[entity_id]) {
+            case AIState::FLEEING:
+            {
+                size_t threat_id = data.target_id[entity_id];
+                if (threat_id == (size_t)-1 || threat_id >= data.getEntityCount() || !data.is_alive[threat_id]) return false;
+                return getFleeGoal(data, entity_id, world, data.x[threat_id], data.y[threat_id], out_x, out_y);
+            }
+
+            case AIState::CHASING:
+            case AIState::PACK_HUNTING:
+            case AIState::HERDING:
+            {
+                size_t target_entity_id = data.target_id[entity_id];
+                if (target_entity_id == (size_t)-1 || target_entity_id >= data.getEntityCount() || !data.is_alive[target_entity_id]) return false;
+                out_x = data.x[target_entity_id];
+                out_y = data.y[target_entity_id];
+                return true;
+            }
+
+            case AIState::SEEKING_FOOD:
+            case AIState::TRACKING:
+                if (data.target_x[entity_id] == -1 || data.target_y[entity_id] == -1) return false;
+                out_x = data.target_x[entity_id];
+                out_y = data.target_y[entity_id];
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    // Whether this turn's greedy diagonal steps towards the goal would run into impassable terrain
+    static bool isGreedyPathBlocked(const EntityManager& data, size_t entity_id, const World& world, int goal_x, int goal_y) {
+        int x = data.x[entity_id];
+        int y = data.y[entity_id];
+        for (int i = 0; i < data.current_speed[entity_id] && (x != goal_x || y != goal_y); ++i) {
+            x += (goal_x > x) - (goal_x < x);
+            y += (goal_y > y) - (goal_y < y);
+            if (!world.canMove(x, y, data.type[entity_id])) return true;
+        }
+        return false;
+    }
+
+    void getSteeringGoal(const World& world, AnimalType type, int x, int y, int goal_x, int goal_y, int& out_x, int& out_y) {
+        out_x = goal_x;
+        out_y = goal_y;
+        if (std::max(std::abs(goal_x - x), std::abs(goal_y - y)) > HPA_MIN_TARGET_DISTANCE) {
+            world.getPathfinder().getWaypoint(world, type, x, y, goal_x, goal_y, out_x, out_y);
+        }
+    }
+
+    void preparePathing(const EntityManager& data, World& world, WorkerPool& pool) {
+        size_t num_entities = data.getEntityCount();
+        HierarchicalPathfinder& pathfinder = world.getPathfinder();
+
+        // 1. Region routes for distant goals (herd joins, flee goals across terrain). One thread
+        //    lists the entities that need one; the team builds missing graphs, keys and routes.
+        size_t* distant = pool.allocateShared<size_t>(num_entities);
+        uint64_t* route_keys = pool.allocateShared<uint64_t>(num_entities);
+        size_t distant_count = 0;
+        unsigned graph_types = 0; // Bit per species whose graph is needed
+        #pragma omp single copyprivate(distant_count, graph_types)
+        for (size_t i = 0; i < num_entities; ++i) {
+            int goal_x, goal_y;
+            if (!data.is_alive[i] || !getMoveGoal(data, i, world, goal_x, goal_y)) continue;
+            if (std::max(std::abs(goal_x - data.x[i]), std::abs(goal_y - data.y[i])) > HPA_MIN_TARGET_DISTANCE) {
+                distant[distant_count++] = i;
+                graph_types |= 1u << static_cast<int>(data.type[i]);
+            }
+        }
+
+        for (int type = 0; type < ANIMAL_TYPE_COUNT; ++type) {
+            if (graph_types & (1u << type)) pathfinder.prepareGraph(static_cast<AnimalType>(type), world);
+        }
+
+        #pragma omp for
+        for (size_t k = 0; k < distant_count; ++k) {
+            size_t i = distant[k];
+            int goal_x, goal_y;
+            getMoveGoal(data, i, world, goal_x, goal_y);
+            route_keys[k] = pathfinder.getRouteKey(world, data.type[i], data.x[i], data.y[i], goal_x, goal_y);
+        }
+        pathfinder.prepareRoutes(route_keys, distant_count);
+
+        // 2. Flow fields towards the goal (or its route waypoint)
+        FlowFieldCache& flow_fields = world.getFlowFields();
+        uint64_t* field_keys = pool.allocateShared<uint64_t>(num_entities);
+        size_t field_key_count = 0;
+        #pragma omp single copyprivate(field_key_count)
+        for (size_t i = 0; i < num_entities; ++i) {
+            int goal_x, goal_y;
+            if (!data.is_alive[i] || !getMoveGoal(data, i, world, goal_x, goal_y)) continue;
+            getSteeringGoal(world, data.type[i], data.x[i], data.y[i], goal_x, goal_y, goal_x, goal_y);
+
+            // Inside the goal region moveTowards steps greedily, so no field is needed; outside the
+            // field's window (a distant goal without a route) it would have no distance to follow
+            if (data.x[i] / FLOW_REGION_SIZE == goal_x / FLOW_REGION_SIZE && data.y[i] / FLOW_REGION_SIZE == goal_y / FLOW_REGION_SIZE) continue;
+            if (!FlowFieldCache::isInWindow(goal_x, goal_y, data.x[i], data.y[i])) continue;
+
+            // Fields are only built once terrain gets in the way, then kept while in use so
+            // entities routing around an obstacle don't fall back to greedy steps into it
+            if (flow_fields.find(data.type[i], goal_x, goal_y) || isGreedyPathBlocked(data, i, world, goal_x, goal_y)) {
+                field_keys[field_key_count++] = FlowFieldCache::getKey(data.type[i], goal_x, goal_y);
+            }
+        }
+        flow_fields.prepare(field_keys, field_key_count, world, world.getTurnCount());
+    }
+
     // Main Movement System run function
     void run(EntityManager& data, const World& world) {
         size_t num_entities = data.getEntityCount();
 
         // --- Parallelize the loop using OpenMP ---
-        // Each thread processes a chunk of entities.
+        // Each thread of the turn's team (see WorkerPool) processes a chunk of entities.
         // Reads (data.state, data.target_id, etc.) are safe.
         // Writes (data.x[i], data.y[i]) must ONLY be to the current entity 'i'. This is true for movement.
-        #pragma omp parallel for
+        #pragma omp for
         for (size_t i = 0; i < num_entities; ++i) {
              if (!data.is_alive[i]) continue;
 
@@ -173,7 +354,13 @@ namespace MovementSystem {
                          int target_y = data.y[target_entity_id];
 
                          if (current_state == AIState::FLEEING) {
-                              moveAwayFrom(data, i, world, target_x, target_y);
+                              // Blocked by terrain: run for the flee goal, around the obstacle
+                              int flee_x, flee_y;
+                              if (getFleeGoal(data, i, world, target_x, target_y, flee_x, flee_y)) {
+                                  moveTowards(data, i, world, flee_x, flee_y);
+                              } else {
+                                  moveAwayFrom(data, i, world, target_x, target_y);
+                              }
                          } else { // CHASING, PACK_HUNTING, HERDING move TOWARDS animal target
                              moveTowards(data, i, world, target_x, target_y);
                          }
@@ -187,6 +374,7 @@ namespace MovementSystem {
                  break;
 
                  case AIState::SEEKING_FOOD:
+                 case AIState::TRACKING: // Both move TOWARDS a tile target
                  {
                      int target_x_coord = data.target_x[i];
                      int target_y_coord = data.target_y[i];